@@ -0,0 +1,76 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+#include "tcob/ai/Pathfinding.hpp"
+#include "tcob/core/Grid.hpp"
+#include "tcob/core/Point.hpp"
+#include "tcob/core/Size.hpp"
+
+namespace tcob::ai {
+////////////////////////////////////////////////////////////
+
+// Direction field towards a single target, shared by any number of units.
+// The grid is only queried on the calling thread, the per-cell pass that
+// derives the fields from the search runs on the task_manager.
+class TCOB_API flow_field final {
+public:
+    explicit flow_field(bool allowDiagonal = true);
+
+    void build(AStarGrid auto&& testGrid, size_i gridExtent, point_i target); //!< searches with a thread-local context
+    void build(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i target);
+
+    auto target() const -> point_i;
+    auto extent() const -> size_i;
+
+    auto is_reachable(point_i pos) const -> bool;
+    auto get_cost(point_i pos) const -> u64;          //!< accumulated cost to the target
+    auto get_direction(point_i pos) const -> point_i; //!< next step towards the target, zero at the target or if unreachable
+
+private:
+    static constexpr std::array<point_i, 9> Directions {{{0, 0}, {0, 1}, {1, 0}, {0, -1}, {-1, 0}, {1, 1}, {-1, -1}, {1, -1}, {-1, 1}}};
+
+    void build_fields(pathfinding_context const& ctx);
+
+    bool      _allowDiagonal;
+    point_i   _target {point_i::Zero};
+    grid<u64> _integration;
+    grid<u8>  _directions; //!< index into Directions
+};
+
+////////////////////////////////////////////////////////////
+
+// Keeps the flow fields of the most recently used targets. All fields are
+// built with one shared search context, each entry only stores its grids.
+class TCOB_API flow_field_cache final {
+public:
+    explicit flow_field_cache(usize capacity = 16, bool allowDiagonal = true);
+
+    auto get(AStarGrid auto&& testGrid, size_i gridExtent, point_i target) -> flow_field const&; //!< reference is valid until the entry gets evicted
+    void clear();                                                                               //!< call after changing costs
+
+private:
+    struct entry {
+        point_i                     Target {};
+        u64                         LastUse {0};
+        std::unique_ptr<flow_field> Field;
+    };
+
+    usize               _capacity;
+    bool                _allowDiagonal;
+    u64                 _useCounter {0};
+    std::vector<entry>  _entries;
+    pathfinding_context _context;
+};
+
+}
+
+#include "FlowField.inl"
@@ -0,0 +1,84 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "FlowField.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include "tcob/ai/Pathfinding.hpp"
+#include "tcob/core/Grid.hpp"
+#include "tcob/core/Point.hpp"
+#include "tcob/core/Size.hpp"
+
+namespace tcob::ai {
+
+void flow_field::build(AStarGrid auto&& testGrid, size_i gridExtent, point_i target)
+{
+    static thread_local pathfinding_context ctx;
+    build(ctx, testGrid, gridExtent, target);
+}
+
+void flow_field::build(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i target)
+{
+    _target = target;
+
+    ctx.prepare(gridExtent);
+
+    if (testGrid.get_cost(target, target) != astar_pathfinding::IMPASSABLE_COST) {
+        // integration field: Dijkstra outwards from the target, along the reversed moves
+        i32 const targetIdx {ctx.index_of(target)};
+        ctx.open(targetIdx, 0, targetIdx);
+        ctx.heap_push({.Score = 0, .Index = targetIdx});
+
+        usize const dirCount {_allowDiagonal ? Directions.size() : 5};
+        while (!ctx.heap_empty()) {
+            i32 const currentIdx {ctx.heap_pop().Index};
+            if (ctx.is_closed(currentIdx)) { continue; }
+            ctx.close(currentIdx);
+
+            point_i const current {ctx.position_of(currentIdx)};
+            for (usize d {1}; d < dirCount; ++d) {
+                point_i const neighbor {current + Directions[d]};
+                if (neighbor.X < 0 || neighbor.X >= gridExtent.Width || neighbor.Y < 0 || neighbor.Y >= gridExtent.Height) { continue; }
+
+                auto const cost {testGrid.get_cost(neighbor, current)};
+                if (cost == astar_pathfinding::IMPASSABLE_COST) { continue; }
+
+                i32 const neighborIdx {ctx.index_of(neighbor)};
+                u64 const tentative_gScore {ctx.get_score(currentIdx) + cost};
+                if (tentative_gScore < ctx.get_score(neighborIdx)) {
+                    ctx.open(neighborIdx, tentative_gScore, currentIdx);
+                    ctx.heap_push({.Score = tentative_gScore, .Index = neighborIdx});
+                }
+            }
+        }
+    }
+
+    build_fields(ctx);
+}
+
+////////////////////////////////////////////////////////////
+
+auto flow_field_cache::get(AStarGrid auto&& testGrid, size_i gridExtent, point_i target) -> flow_field const&
+{
+    ++_useCounter;
+
+    if (auto it {std::ranges::find(_entries, target, &entry::Target)}; it != _entries.end()) {
+        it->LastUse = _useCounter;
+        return *it->Field;
+    }
+
+    // evict the least recently used entry and reuse its memory
+    entry& slot {_entries.size() < _capacity ? _entries.emplace_back() : *std::ranges::min_element(_entries, {}, &entry::LastUse)};
+    if (!slot.Field) { slot.Field = std::make_unique<flow_field>(_allowDiagonal); }
+    slot.Target  = target;
+    slot.LastUse = _useCounter;
+    slot.Field->build(_context, testGrid, gridExtent, target);
+    return *slot.Field;
+}
+
+}
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "tcob/ai/Pathfinding.hpp"
+#include "tcob/core/Point.hpp"
+#include "tcob/core/Rect.hpp"
+#include "tcob/core/Size.hpp"
+
+namespace tcob::ai {
+////////////////////////////////////////////////////////////
+
+struct path_request {
+    point_i Start;
+    point_i Finish;
+};
+
+////////////////////////////////////////////////////////////
+
+// Runs batches of path queries on the task_manager and caches the results per
+// (start region, finish). A cached path is reused for every start in the same
+// region by prepending a short path to the cached start.
+// get_cost of the grid must be safe to call concurrently and the grid must not
+// change while a batch is running.
+template <AStarGrid G>
+class path_service final {
+public:
+    using path = std::vector<point_i>;
+
+    path_service(G& grid, size_i gridExtent, astar_pathfinding pathfinding = astar_pathfinding {}, i32 regionSize = 8, usize cacheCapacity = 4096);
+
+    auto find_paths(std::span<path_request const> requests) -> std::vector<path>;            //!< blocks until all requests are done
+    auto find_paths_async(std::vector<path_request> requests) -> std::future<std::vector<path>>; //!< the service must outlive the future
+
+    void invalidate();                   //!< drops all cached paths
+    void invalidate(rect_i const& area); //!< drops the cached paths crossing the area
+
+    auto cache_size() -> usize;
+
+private:
+    struct cache_key {
+        point_i Region;
+        point_i Finish;
+
+        auto operator==(cache_key const& other) const -> bool = default;
+    };
+
+    struct cache_key_hash {
+        auto operator()(cache_key const& key) const -> usize;
+    };
+
+    struct cache_entry {
+        point_i Start;
+        path    Path;
+        u64     LastUse {0};
+    };
+
+    using context_set = std::vector<pathfinding_context>;
+
+    auto find_path(pathfinding_context& ctx, path_request const& request, u64 version) -> path;
+    auto lookup(pathfinding_context& ctx, path_request const& request, path& out) -> bool;
+    void store(path_request const& request, path const& path, u64 version);
+
+    auto acquire_contexts() -> std::unique_ptr<context_set>;
+    void release_contexts(std::unique_ptr<context_set> contexts);
+
+    auto region_of(point_i pos) const -> point_i;
+
+    G&                _grid;
+    size_i            _extent;
+    astar_pathfinding _pathfinding;
+    i32               _regionSize;
+    usize             _cacheCapacity;
+
+    std::mutex                                                 _cacheMutex;
+    std::unordered_map<cache_key, cache_entry, cache_key_hash> _cache;
+    u64                                                        _useCounter {0};
+    u64                                                        _version {0}; //!< bumped on invalidation, stale results are not cached
+
+    std::mutex                                _contextMutex;
+    std::vector<std::unique_ptr<context_set>> _contexts; //!< one set per concurrently running batch
+};
+
+}
+
+#include "PathService.inl"
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "PathService.hpp"
+
+#include <algorithm>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <vector>
+
+#include "tcob/core/Common.hpp"
+#include "tcob/core/ServiceLocator.hpp"
+#include "tcob/core/TaskManager.hpp"
+
+namespace tcob::ai {
+
+template <AStarGrid G>
+inline path_service<G>::path_service(G& grid, size_i gridExtent, astar_pathfinding pathfinding, i32 regionSize, usize cacheCapacity)
+    : _grid {grid}
+    , _extent {gridExtent}
+    , _pathfinding {std::move(pathfinding)}
+    , _regionSize {std::max(regionSize, 1)}
+    , _cacheCapacity {cacheCapacity}
+{
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::find_paths(std::span<path_request const> requests) -> std::vector<path>
+{
+    std::vector<path> retValue(requests.size());
+    if (requests.empty()) { return retValue; }
+
+    u64 version {0};
+    {
+        std::scoped_lock lock {_cacheMutex};
+        version = _version;
+    }
+
+    auto& tm {locate_service<task_manager>()};
+    auto  contexts {acquire_contexts()};
+    contexts->resize(static_cast<usize>(std::max<isize>(1, tm.thread_count())));
+
+    tm.run_parallel(
+        [&](par_task const& task) {
+            auto& ctx {(*contexts)[static_cast<usize>(task.Thread)]};
+            for (isize i {task.Start}; i < task.End; ++i) {
+                retValue[static_cast<usize>(i)] = find_path(ctx, requests[static_cast<usize>(i)], version);
+            }
+        },
+        std::ssize(requests));
+
+    release_contexts(std::move(contexts));
+    return retValue;
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::find_paths_async(std::vector<path_request> requests) -> std::future<std::vector<path>>
+{
+    return locate_service<task_manager>().run_async<std::vector<path>>([this, requests = std::move(requests)] {
+        return find_paths(requests);
+    });
+}
+
+template <AStarGrid G>
+inline void path_service<G>::invalidate()
+{
+    std::scoped_lock lock {_cacheMutex};
+    _cache.clear();
+    ++_version;
+}
+
+template <AStarGrid G>
+inline void path_service<G>::invalidate(rect_i const& area)
+{
+    std::scoped_lock lock {_cacheMutex};
+    std::erase_if(_cache, [&area](auto const& kv) {
+        auto const& entry {kv.second};
+        return area.contains(entry.Start) || std::ranges::any_of(entry.Path, [&area](point_i p) { return area.contains(p); });
+    });
+    ++_version;
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::cache_size() -> usize
+{
+    std::scoped_lock lock {_cacheMutex};
+    return _cache.size();
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::find_path(pathfinding_context& ctx, path_request const& request, u64 version) -> path
+{
+    path retValue;
+    if (lookup(ctx, request, retValue)) { return retValue; }
+
+    retValue = _pathfinding.find_path(ctx, _grid, _extent, request.Start, request.Finish);
+    store(request, retValue, version);
+    return retValue;
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::lookup(pathfinding_context& ctx, path_request const& request, path& out) -> bool
+{
+    if (request.Start == request.Finish) { return false; }
+
+    point_i cachedStart;
+    path    cachedPath;
+    {
+        std::scoped_lock lock {_cacheMutex};
+        auto             it {_cache.find({.Region = region_of(request.Start), .Finish = request.Finish})};
+        if (it == _cache.end()) { return false; }
+
+        it->second.LastUse = ++_useCounter;
+        cachedStart        = it->second.Start;
+        cachedPath         = it->second.Path;
+    }
+
+    if (cachedStart == request.Start) {
+        out = std::move(cachedPath);
+        return true;
+    }
+
+    // the start lies on the cached path
+    if (auto it {std::ranges::find(cachedPath, request.Start)}; it != cachedPath.end()) {
+        out.assign(it + 1, cachedPath.end());
+        return true;
+    }
+
+    // otherwise walk to the cached start first, but join the cached path at the first cell both share
+    out = _pathfinding.find_path(ctx, _grid, _extent, request.Start, cachedStart);
+    if (out.empty()) { return false; }
+
+    for (auto walkIt {out.begin()}; walkIt != out.end(); ++walkIt) {
+        if (auto pathIt {std::ranges::find(cachedPath, *walkIt)}; pathIt != cachedPath.end()) {
+            out.erase(walkIt + 1, out.end());
+            out.insert(out.end(), pathIt + 1, cachedPath.end());
+            return true;
+        }
+    }
+
+    out.insert(out.end(), cachedPath.begin(), cachedPath.end());
+    return true;
+}
+
+template <AStarGrid G>
+inline void path_service<G>::store(path_request const& request, path const& path, u64 version)
+{
+    if (path.empty() || request.Start == request.Finish || _cacheCapacity == 0) { return; }
+
+    std::scoped_lock lock {_cacheMutex};
+    if (version != _version) { return; } // computed on an outdated grid
+
+    if (_cache.size() >= _cacheCapacity) {
+        // drop the least recently used quarter at once
+        std::vector<u64> uses;
+        uses.reserve(_cache.size());
+        for (auto const& [_, entry] : _cache) { uses.push_back(entry.LastUse); }
+        auto const nth {uses.begin() + static_cast<isize>(uses.size() / 4)};
+        std::ranges::nth_element(uses, nth);
+        u64 const threshold {*nth};
+        std::erase_if(_cache, [threshold](auto const& kv) { return kv.second.LastUse <= threshold; });
+    }
+
+    _cache.insert_or_assign({.Region = region_of(request.Start), .Finish = request.Finish},
+                            cache_entry {.Start = request.Start, .Path = path, .LastUse = ++_useCounter});
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::acquire_contexts() -> std::unique_ptr<context_set>
+{
+    std::scoped_lock lock {_contextMutex};
+    if (_contexts.empty()) { return std::make_unique<context_set>(); }
+
+    auto retValue {std::move(_contexts.back())};
+    _contexts.pop_back();
+    return retValue;
+}
+
+template <AStarGrid G>
+inline void path_service<G>::release_contexts(std::unique_ptr<context_set> contexts)
+{
+    std::scoped_lock lock {_contextMutex};
+    _contexts.push_back(std::move(contexts));
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::region_of(point_i pos) const -> point_i
+{
+    return {pos.X / _regionSize, pos.Y / _regionSize};
+}
+
+template <AStarGrid G>
+inline auto path_service<G>::cache_key_hash::operator()(cache_key const& key) const -> usize
+{
+    return helper::hash_combine(std::hash<point_i> {}(key.Region), std::hash<point_i> {}(key.Finish));
+}
+
+}
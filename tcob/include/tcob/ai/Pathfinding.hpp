@@ -6,11 +6,12 @@
 #pragma once
 #include "tcob/tcob_config.hpp"
 
+#include <array>
 #include <limits>
-#include <unordered_map>
 #include <vector>
 
 #include "tcob/core/Point.hpp"
+#include "tcob/core/Rect.hpp"
 #include "tcob/core/Size.hpp"
 
 namespace tcob::ai {
@@ -24,6 +25,52 @@ concept AStarGrid =
 
 ////////////////////////////////////////////////////////////
 
+// Scratch memory for path queries. Reusing one context per thread avoids all
+// per-query allocations once it has grown to the largest grid.
+class TCOB_API pathfinding_context final {
+    friend class astar_pathfinding;
+    friend class flow_field;
+    friend class hpa_pathfinding;
+
+public:
+    pathfinding_context() = default;
+
+    void reserve(size_i gridExtent);
+
+private:
+    struct heap_node {
+        u64 Score {};
+        i32 Index {};
+    };
+
+    void prepare(size_i gridExtent);
+
+    auto index_of(point_i pos) const -> i32;
+    auto position_of(i32 idx) const -> point_i;
+
+    auto is_open(i32 idx) const -> bool;
+    auto is_closed(i32 idx) const -> bool;
+    auto get_score(i32 idx) const -> u64;
+    void open(i32 idx, u64 gScore, i32 parent);
+    void close(i32 idx);
+
+    auto heap_empty() const -> bool;
+    void heap_push(heap_node node);
+    auto heap_pop() -> heap_node;
+
+    auto reconstruct_path(i32 start, i32 finish) const -> std::vector<point_i>;
+
+    size_i                 _extent {size_i::Zero};
+    std::vector<u64>       _gScore;
+    std::vector<i32>       _parent;
+    std::vector<u32>       _openStamp;   //!< == _generation if the node was reached in the current query
+    std::vector<u32>       _closedStamp; //!< == _generation if the node was expanded in the current query
+    u32                    _generation {0};
+    std::vector<heap_node> _heap;        //!< 4-ary min-heap
+};
+
+////////////////////////////////////////////////////////////
+
 class TCOB_API astar_pathfinding final {
 public:
     enum class heuristic : u8 {
@@ -32,27 +79,102 @@ public:
         Chebyshev
     };
 
-    explicit astar_pathfinding(bool allowDiagonal = false, heuristic heuristic = heuristic::Manhattan);
+    enum class search : u8 {
+        AStar,
+        JumpPoint //!< uniform-cost grids with diagonal movement only, falls back to AStar otherwise
+    };
+
+    explicit astar_pathfinding(bool allowDiagonal = false, heuristic heuristic = heuristic::Manhattan, search search = search::AStar);
 
     static constexpr u64 IMPASSABLE_COST = std::numeric_limits<u64>::max();
 
-    auto find_path(AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) -> std::vector<point_i>;
+    auto find_path(AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>; //!< uses a thread-local context
+    auto find_path(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>;
 
 private:
-    class TCOB_API node {
-    public:
-        point_i pos;
-        u64     score {};
+    static constexpr std::array<point_i, 4> OrthogonalDirections {{{0, 1}, {1, 0}, {0, -1}, {-1, 0}}};
+    static constexpr std::array<point_i, 4> DiagonalDirections {{{1, 1}, {-1, -1}, {1, -1}, {-1, 1}}};
 
-        auto operator>(node const& other) const -> bool;
-    };
+    // jump point search moves at uniform cost, diagonal steps never cut corners
+    static constexpr u64 StraightCost {10};
+    static constexpr u64 DiagonalCost {14};
 
     auto distance(point_i a, point_i b) const -> u64;
-    auto neighbors(size_i gridSize, point_i pos) const -> std::vector<point_i>;
-    auto reconstruct_path(std::unordered_map<point_i, point_i> const& cameFrom, point_i current) const -> std::vector<point_i>;
+    static auto octile_distance(point_i a, point_i b) -> u64;
+
+    auto find_path_astar(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>;
+    auto find_path_jps(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>;
 
     bool      _allowDiagonal;
     heuristic _heuristic;
+    search    _search;
+};
+
+////////////////////////////////////////////////////////////
+
+// Hierarchical A*: the grid is split into clusters connected by an abstract
+// graph of border entrances. Queries search the abstract graph and refine each
+// step with a local A* inside a single cluster. Paths are near-optimal.
+class TCOB_API hpa_pathfinding final {
+public:
+    explicit hpa_pathfinding(i32 clusterSize = 16, bool allowDiagonal = false);
+
+    void build(AStarGrid auto&& testGrid, size_i gridExtent);
+    void invalidate(rect_i const& area); //!< call after changing costs, affected clusters are rebuilt on the next query
+
+    auto find_path(AStarGrid auto&& testGrid, point_i start, point_i finish) -> std::vector<point_i>;
+
+    auto node_count() const -> usize;
+    auto edge_count() const -> usize;
+
+private:
+    struct edge {
+        i32 Target {};
+        u64 Cost {};
+    };
+
+    struct node {
+        point_i           Position {};
+        i32               Cluster {-1};
+        i32               Partner {-1}; //!< node on the other side of the entrance
+        u64               PartnerCost {};
+        std::vector<edge> Edges {};     //!< to the other nodes of the same cluster
+    };
+
+    struct cluster {
+        rect_i                          Bounds {};
+        std::vector<i32>                Nodes {};
+        std::array<std::vector<i32>, 2> Borders {}; //!< entrance nodes of the right and bottom border (with its diagonal corners), both sides
+        bool                            Dirty {true};
+    };
+
+    void update(AStarGrid auto&& testGrid);
+    void build_border(AStarGrid auto&& testGrid, i32 clusterIdx, usize border);
+    void build_edges(AStarGrid auto&& testGrid, i32 clusterIdx);
+    auto find_local_path(AStarGrid auto&& testGrid, rect_i const& bounds, point_i start, point_i finish) -> std::vector<point_i>;
+    auto path_cost(AStarGrid auto&& testGrid, point_i start, std::vector<point_i> const& path) const -> u64;
+    void local_costs(AStarGrid auto&& testGrid, i32 clusterIdx, point_i source, bool reverse, std::vector<edge>& edges);
+
+    auto cluster_of(point_i pos) const -> i32;
+    auto neighbor_cluster(i32 clusterIdx, usize border) const -> i32;
+    auto add_node(point_i pos, i32 clusterIdx) -> i32;
+    void clear_border(i32 clusterIdx, usize border);
+    auto distance(point_i a, point_i b) const -> u64;
+
+    i32    _clusterSize;
+    bool   _allowDiagonal;
+    size_i _extent {size_i::Zero};
+    size_i _clusterCount {size_i::Zero};
+    bool   _isDirty {false};
+
+    std::vector<cluster> _clusters;
+    std::vector<node>    _nodes;
+    std::vector<i32>     _freeNodes;
+
+    astar_pathfinding   _local;
+    pathfinding_context _localContext;
+    pathfinding_context _abstractContext;
+    std::vector<u8>     _targetCells;
 };
 
 }
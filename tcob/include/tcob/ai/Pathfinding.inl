@@ -6,59 +6,555 @@
 #pragma once
 #include "Pathfinding.hpp"
 
-#include <functional>
-#include <queue>
-#include <unordered_map>
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <optional>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
-#include "tcob/core/Grid.hpp"
 #include "tcob/core/Point.hpp"
 #include "tcob/core/Size.hpp"
 
 namespace tcob::ai {
 
-auto astar_pathfinding::find_path(AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) -> std::vector<point_i>
+auto astar_pathfinding::find_path(AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>
+{
+    // one context per thread, so concurrent queries on the same instance don't share scratch memory
+    static thread_local pathfinding_context ctx;
+    return find_path(ctx, testGrid, gridExtent, start, finish);
+}
+
+auto astar_pathfinding::find_path(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>
 {
     if (start == finish) { return {start}; }
     if (testGrid.get_cost(start, start) == IMPASSABLE_COST || testGrid.get_cost(finish, finish) == IMPASSABLE_COST) { return {}; }
 
-    std::priority_queue<node, std::vector<node>, std::greater<>> openSet;
-    std::unordered_map<point_i, point_i>                         cameFrom;
+    ctx.prepare(gridExtent);
+
+    if (_search == search::JumpPoint && _allowDiagonal) {
+        return find_path_jps(ctx, testGrid, gridExtent, start, finish);
+    }
+    return find_path_astar(ctx, testGrid, gridExtent, start, finish);
+}
 
-    grid<u64> gScore {gridExtent, IMPASSABLE_COST};
-    grid<u64> fScore {gridExtent, IMPASSABLE_COST};
+auto astar_pathfinding::find_path_astar(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>
+{
+    i32 const startIdx {ctx.index_of(start)};
+    i32 const finishIdx {ctx.index_of(finish)};
 
-    gScore[start] = 0;
-    fScore[start] = distance(start, finish);
+    ctx.open(startIdx, 0, startIdx);
+    ctx.heap_push({.Score = distance(start, finish), .Index = startIdx});
 
-    openSet.push({start, fScore[start]});
+    auto const visit {[&](point_i current, i32 currentIdx, point_i dir) {
+        point_i const neighbor {current + dir};
+        if (neighbor.X < 0 || neighbor.X >= gridExtent.Width || neighbor.Y < 0 || neighbor.Y >= gridExtent.Height) { return; }
 
-    while (!openSet.empty()) {
-        point_i const current {openSet.top().pos};
-        openSet.pop();
+        auto const cost {testGrid.get_cost(current, neighbor)};
+        if (cost == IMPASSABLE_COST) { return; }
 
-        if (current == finish) {
-            return reconstruct_path(cameFrom, current);
+        i32 const neighborIdx {ctx.index_of(neighbor)};
+        u64 const tentative_gScore {ctx.get_score(currentIdx) + cost};
+        if (tentative_gScore < ctx.get_score(neighborIdx)) {
+            ctx.open(neighborIdx, tentative_gScore, currentIdx);
+            ctx.heap_push({.Score = tentative_gScore + distance(neighbor, finish), .Index = neighborIdx});
         }
+    }};
+
+    while (!ctx.heap_empty()) {
+        i32 const currentIdx {ctx.heap_pop().Index};
+
+        // Skip if we already expanded this node with a better path
+        if (ctx.is_closed(currentIdx)) { continue; }
+        if (currentIdx == finishIdx) { return ctx.reconstruct_path(startIdx, finishIdx); }
+        ctx.close(currentIdx);
+
+        point_i const current {ctx.position_of(currentIdx)};
+        for (auto const& dir : OrthogonalDirections) { visit(current, currentIdx, dir); }
+        if (_allowDiagonal) {
+            for (auto const& dir : DiagonalDirections) { visit(current, currentIdx, dir); }
+        }
+    }
+
+    return {}; // No path found
+}
+
+auto astar_pathfinding::find_path_jps(pathfinding_context& ctx, AStarGrid auto&& testGrid, size_i gridExtent, point_i start, point_i finish) const -> std::vector<point_i>
+{
+    auto const walkable {[&](point_i p) {
+        return p.X >= 0 && p.X < gridExtent.Width && p.Y >= 0 && p.Y < gridExtent.Height
+            && testGrid.get_cost(p, p) != IMPASSABLE_COST;
+    }};
+
+    // straight jumps stop at the finish or at nodes with forced neighbors
+    auto const jumpStraight {[&](point_i p, point_i dir) -> std::optional<point_i> {
+        for (;; p += dir) {
+            if (!walkable(p)) { return std::nullopt; }
+            if (p == finish) { return p; }
+
+            if (dir.X != 0) {
+                if ((walkable({p.X, p.Y - 1}) && !walkable({p.X - dir.X, p.Y - 1}))
+                    || (walkable({p.X, p.Y + 1}) && !walkable({p.X - dir.X, p.Y + 1}))) {
+                    return p;
+                }
+            } else {
+                if ((walkable({p.X - 1, p.Y}) && !walkable({p.X - 1, p.Y - dir.Y}))
+                    || (walkable({p.X + 1, p.Y}) && !walkable({p.X + 1, p.Y - dir.Y}))) {
+                    return p;
+                }
+            }
+        }
+    }};
+
+    // diagonal jumps stop wherever one of the straight jumps finds a jump point
+    auto const jump {[&](point_i p, point_i dir) -> std::optional<point_i> {
+        if (dir.X == 0 || dir.Y == 0) { return jumpStraight(p, dir); }
+
+        for (;; p += dir) {
+            if (!walkable(p)) { return std::nullopt; }
+            if (p == finish) { return p; }
+
+            if (jumpStraight({p.X + dir.X, p.Y}, {dir.X, 0}) || jumpStraight({p.X, p.Y + dir.Y}, {0, dir.Y})) { return p; }
+            if (!walkable({p.X + dir.X, p.Y}) || !walkable({p.X, p.Y + dir.Y})) { return std::nullopt; }
+        }
+    }};
+
+    std::array<point_i, 8> dirs {};
+    auto const pruneDirections {[&](point_i p, i32 parentIdx) -> usize {
+        usize count {0};
+
+        if (parentIdx == ctx.index_of(p)) { // start node
+            for (auto const& dir : OrthogonalDirections) {
+                if (walkable(p + dir)) { dirs[count++] = dir; }
+            }
+            for (auto const& dir : DiagonalDirections) {
+                if (walkable(p + dir) && walkable({p.X + dir.X, p.Y}) && walkable({p.X, p.Y + dir.Y})) { dirs[count++] = dir; }
+            }
+            return count;
+        }
+
+        point_i const parent {ctx.position_of(parentIdx)};
+        point_i const d {std::clamp(p.X - parent.X, -1, 1), std::clamp(p.Y - parent.Y, -1, 1)};
+
+        if (d.X != 0 && d.Y != 0) {
+            bool const horizontal {walkable({p.X + d.X, p.Y})};
+            bool const vertical {walkable({p.X, p.Y + d.Y})};
+            if (vertical) { dirs[count++] = {0, d.Y}; }
+            if (horizontal) { dirs[count++] = {d.X, 0}; }
+            if (horizontal && vertical) { dirs[count++] = d; }
+        } else if (d.X != 0) {
+            bool const next {walkable({p.X + d.X, p.Y})};
+            bool const up {walkable({p.X, p.Y - 1})};
+            bool const down {walkable({p.X, p.Y + 1})};
+            if (next) {
+                dirs[count++] = d;
+                if (up) { dirs[count++] = {d.X, -1}; }
+                if (down) { dirs[count++] = {d.X, 1}; }
+            }
+            if (up) { dirs[count++] = {0, -1}; }
+            if (down) { dirs[count++] = {0, 1}; }
+        } else {
+            bool const next {walkable({p.X, p.Y + d.Y})};
+            bool const left {walkable({p.X - 1, p.Y})};
+            bool const right {walkable({p.X + 1, p.Y})};
+            if (next) {
+                dirs[count++] = d;
+                if (left) { dirs[count++] = {-1, d.Y}; }
+                if (right) { dirs[count++] = {1, d.Y}; }
+            }
+            if (left) { dirs[count++] = {-1, 0}; }
+            if (right) { dirs[count++] = {1, 0}; }
+        }
+
+        return count;
+    }};
+
+    i32 const startIdx {ctx.index_of(start)};
+    i32 const finishIdx {ctx.index_of(finish)};
 
-        // Skip if we already found a better path to this node
-        if (gScore[current] == IMPASSABLE_COST) { continue; }
+    ctx.open(startIdx, 0, startIdx);
+    ctx.heap_push({.Score = octile_distance(start, finish), .Index = startIdx});
 
-        for (auto const& neighbor : neighbors(gridExtent, current)) {
-            auto const cost {testGrid.get_cost(current, neighbor)};
-            if (cost == IMPASSABLE_COST) { continue; }
+    while (!ctx.heap_empty()) {
+        i32 const currentIdx {ctx.heap_pop().Index};
 
-            u64 const tentative_gScore {gScore[current] + cost};
+        if (ctx.is_closed(currentIdx)) { continue; }
+        if (currentIdx == finishIdx) { return ctx.reconstruct_path(startIdx, finishIdx); }
+        ctx.close(currentIdx);
 
-            if (tentative_gScore < gScore[neighbor]) {
-                cameFrom[neighbor] = current;
-                gScore[neighbor]   = tentative_gScore;
-                fScore[neighbor]   = tentative_gScore + distance(neighbor, finish);
-                openSet.push({neighbor, fScore[neighbor]});
+        point_i const current {ctx.position_of(currentIdx)};
+        usize const   count {pruneDirections(current, ctx._parent[static_cast<usize>(currentIdx)])};
+        for (usize i {0}; i < count; ++i) {
+            auto const jumpPoint {jump(current + dirs[i], dirs[i])};
+            if (!jumpPoint) { continue; }
+
+            i32 const jumpIdx {ctx.index_of(*jumpPoint)};
+            u64 const tentative_gScore {ctx.get_score(currentIdx) + octile_distance(current, *jumpPoint)};
+            if (tentative_gScore < ctx.get_score(jumpIdx)) {
+                ctx.open(jumpIdx, tentative_gScore, currentIdx);
+                ctx.heap_push({.Score = tentative_gScore + octile_distance(*jumpPoint, finish), .Index = jumpIdx});
             }
         }
     }
 
     return {}; // No path found
 }
+
+////////////////////////////////////////////////////////////
+
+namespace detail {
+    // restricts a grid to a single cluster, in cluster coordinates
+    template <typename G>
+    class cluster_grid {
+    public:
+        G&      Grid;
+        point_i Offset;
+
+        auto get_cost(point_i from, point_i to) const -> u64 { return Grid.get_cost(from + Offset, to + Offset); }
+    };
+}
+
+void hpa_pathfinding::build(AStarGrid auto&& testGrid, size_i gridExtent)
+{
+    _extent       = gridExtent;
+    _clusterCount = {(gridExtent.Width + _clusterSize - 1) / _clusterSize, (gridExtent.Height + _clusterSize - 1) / _clusterSize};
+
+    _nodes.clear();
+    _freeNodes.clear();
+    _clusters.assign(static_cast<usize>(_clusterCount.Width * _clusterCount.Height), {});
+    for (i32 y {0}; y < _clusterCount.Height; ++y) {
+        for (i32 x {0}; x < _clusterCount.Width; ++x) {
+            point_i const pos {x * _clusterSize, y * _clusterSize};
+            _clusters[static_cast<usize>((y * _clusterCount.Width) + x)].Bounds =
+                {pos, {std::min(_clusterSize, gridExtent.Width - pos.X), std::min(_clusterSize, gridExtent.Height - pos.Y)}};
+        }
+    }
+
+    _isDirty = true;
+    update(testGrid);
+}
+
+auto hpa_pathfinding::find_path(AStarGrid auto&& testGrid, point_i start, point_i finish) -> std::vector<point_i>
+{
+    if (start == finish) { return {start}; }
+    if (testGrid.get_cost(start, start) == astar_pathfinding::IMPASSABLE_COST || testGrid.get_cost(finish, finish) == astar_pathfinding::IMPASSABLE_COST) { return {}; }
+
+    update(testGrid);
+
+    i32 const startCluster {cluster_of(start)};
+    i32 const finishCluster {cluster_of(finish)};
+
+    // start and finish are temporary nodes behind the regular ones
+    i32 const startId {static_cast<i32>(_nodes.size())};
+    i32 const finishId {startId + 1};
+
+    std::vector<edge> startEdges;
+    local_costs(testGrid, startCluster, start, false, startEdges);
+
+    // in the same or a neighboring cluster a direct path competes with the abstract graph,
+    // entrances can be far off the straight line for short queries
+    auto const& startBounds {_clusters[static_cast<usize>(startCluster)].Bounds};
+    auto const& finishBounds {_clusters[static_cast<usize>(finishCluster)].Bounds};
+    i32 const   clusterDX {std::abs((startCluster % _clusterCount.Width) - (finishCluster % _clusterCount.Width))};
+    i32 const   clusterDY {std::abs((startCluster / _clusterCount.Width) - (finishCluster / _clusterCount.Width))};
+
+    std::vector<point_i> directPath;
+    if (clusterDX <= 1 && clusterDY <= 1) {
+        directPath = find_local_path(testGrid, startBounds.as_union_with(finishBounds), start, finish);
+        if (!directPath.empty()) { startEdges.push_back({.Target = finishId, .Cost = path_cost(testGrid, start, directPath)}); }
+    }
+    std::vector<edge> finishEdges;
+    local_costs(testGrid, finishCluster, finish, true, finishEdges);
+    if (startEdges.empty()) { return {}; }
+
+    auto const position {[&](i32 id) {
+        if (id == startId) { return start; }
+        if (id == finishId) { return finish; }
+        return _nodes[static_cast<usize>(id)].Position;
+    }};
+
+    // A* on the abstract graph
+    auto& ctx {_abstractContext};
+    ctx.prepare({finishId + 1, 1});
+    ctx.open(startId, 0, startId);
+    ctx.heap_push({.Score = distance(start, finish), .Index = startId});
+
+    auto const relax {[&](i32 current, i32 target, u64 cost) {
+        u64 const tentative_gScore {ctx.get_score(current) + cost};
+        if (tentative_gScore < ctx.get_score(target)) {
+            ctx.open(target, tentative_gScore, current);
+            ctx.heap_push({.Score = tentative_gScore + distance(position(target), finish), .Index = target});
+        }
+    }};
+
+    bool found {false};
+    while (!ctx.heap_empty()) {
+        i32 const current {ctx.heap_pop().Index};
+
+        if (ctx.is_closed(current)) { continue; }
+        if (current == finishId) {
+            found = true;
+            break;
+        }
+        ctx.close(current);
+
+        if (current == startId) {
+            for (auto const& e : startEdges) { relax(current, e.Target, e.Cost); }
+            continue;
+        }
+
+        auto const& n {_nodes[static_cast<usize>(current)]};
+        if (n.Partner >= 0) { relax(current, n.Partner, n.PartnerCost); }
+        for (auto const& e : n.Edges) { relax(current, e.Target, e.Cost); }
+        if (n.Cluster == finishCluster) {
+            for (auto const& e : finishEdges) {
+                if (e.Target == current) { relax(current, finishId, e.Cost); }
+            }
+        }
+    }
+    if (!found) { return {}; } // No path found
+
+    std::vector<i32> abstractPath;
+    for (i32 id {finishId}; id != startId; id = ctx._parent[static_cast<usize>(id)]) { abstractPath.push_back(id); }
+    abstractPath.push_back(startId);
+    std::ranges::reverse(abstractPath);
+
+    // refine each abstract step
+    std::vector<point_i> retValue;
+    for (usize i {1}; i < abstractPath.size(); ++i) {
+        i32 const     from {abstractPath[i - 1]};
+        i32 const     to {abstractPath[i]};
+        point_i const fromPos {position(from)};
+        point_i const toPos {position(to)};
+        if (fromPos == toPos) { continue; }
+
+        if (from == startId && to == finishId) {
+            retValue = std::move(directPath);
+            continue;
+        }
+        if (from != startId && _nodes[static_cast<usize>(from)].Partner == to) {
+            retValue.push_back(toPos);
+            continue;
+        }
+
+        i32 const  clusterIdx {from == startId ? startCluster : _nodes[static_cast<usize>(from)].Cluster};
+        auto const segment {find_local_path(testGrid, _clusters[static_cast<usize>(clusterIdx)].Bounds, fromPos, toPos)};
+        retValue.insert(retValue.end(), segment.begin(), segment.end());
+    }
+
+    return retValue;
+}
+
+void hpa_pathfinding::update(AStarGrid auto&& testGrid)
+{
+    if (!_isDirty) { return; }
+    _isDirty = false;
+
+    // a dirty cluster changes its own borders and the borders it shares with its left and top neighbors,
+    // with diagonal movement also the bottom borders of its top corners
+    std::vector<u8> borders(_clusters.size() * 2, 0);
+    std::vector<u8> edges(_clusters.size(), 0);
+
+    for (i32 c {0}; c < std::ssize(_clusters); ++c) {
+        if (!_clusters[static_cast<usize>(c)].Dirty) { continue; }
+        _clusters[static_cast<usize>(c)].Dirty = false;
+
+        i32 const x {c % _clusterCount.Width};
+        i32 const y {c / _clusterCount.Width};
+
+        borders[static_cast<usize>(c * 2)]     = 1;
+        borders[static_cast<usize>(c * 2) + 1] = 1;
+        if (x > 0) { borders[static_cast<usize>((c - 1) * 2)] = 1; }
+        if (y > 0) { borders[static_cast<usize>((c - _clusterCount.Width) * 2) + 1] = 1; }
+        if (_allowDiagonal && y > 0) {
+            if (x > 0) { borders[static_cast<usize>((c - _clusterCount.Width - 1) * 2) + 1] = 1; }
+            if (x < _clusterCount.Width - 1) { borders[static_cast<usize>((c - _clusterCount.Width + 1) * 2) + 1] = 1; }
+        }
+
+        edges[static_cast<usize>(c)] = 1;
+    }
+
+    // every cluster that gains or loses border nodes needs new intra-cluster edges
+    auto const markEdges {[&](usize b) {
+        for (i32 const id : _clusters[b / 2].Borders[b % 2]) { edges[static_cast<usize>(_nodes[static_cast<usize>(id)].Cluster)] = 1; }
+    }};
+
+    for (usize b {0}; b < borders.size(); ++b) {
+        if (!borders[b]) { continue; }
+        markEdges(b);
+        clear_border(static_cast<i32>(b / 2), b % 2);
+    }
+    for (usize b {0}; b < borders.size(); ++b) {
+        if (!borders[b]) { continue; }
+        build_border(testGrid, static_cast<i32>(b / 2), b % 2);
+        markEdges(b);
+    }
+    for (usize c {0}; c < edges.size(); ++c) {
+        if (edges[c]) { build_edges(testGrid, static_cast<i32>(c)); }
+    }
+}
+
+void hpa_pathfinding::build_border(AStarGrid auto&& testGrid, i32 clusterIdx, usize border)
+{
+    i32 const neighborIdx {neighbor_cluster(clusterIdx, border)};
+    if (neighborIdx < 0) { return; }
+
+    auto const& bounds {_clusters[static_cast<usize>(clusterIdx)].Bounds};
+    bool const  vertical {border == 0};
+    i32 const   length {vertical ? bounds.height() : bounds.width()};
+
+    auto const inner {[&](i32 i) { return vertical ? point_i {bounds.right() - 1, bounds.top() + i} : point_i {bounds.left() + i, bounds.bottom() - 1}; }};
+    auto const outer {[&](i32 i) { return vertical ? point_i {bounds.right(), bounds.top() + i} : point_i {bounds.left() + i, bounds.bottom()}; }};
+    auto const canCross {[&](point_i a, point_i b) {
+        return b.X >= 0 && b.X < _extent.Width && b.Y >= 0 && b.Y < _extent.Height
+            && testGrid.get_cost(a, b) != astar_pathfinding::IMPASSABLE_COST
+            && testGrid.get_cost(b, a) != astar_pathfinding::IMPASSABLE_COST;
+    }};
+
+    auto const isOpen {[&](i32 i) { return canCross(inner(i), outer(i)); }};
+
+    auto const addEntrance {[&](i32 i, i32 offset) {
+        point_i const a {inner(i)};
+        point_i const b {outer(i + offset)};
+        i32 const     na {add_node(a, clusterIdx)};
+        i32 const     nb {add_node(b, cluster_of(b))};
+
+        _nodes[static_cast<usize>(na)].Partner     = nb;
+        _nodes[static_cast<usize>(na)].PartnerCost = testGrid.get_cost(a, b);
+        _nodes[static_cast<usize>(nb)].Partner     = na;
+        _nodes[static_cast<usize>(nb)].PartnerCost = testGrid.get_cost(b, a);
+
+        auto& nodes {_clusters[static_cast<usize>(clusterIdx)].Borders[border]};
+        nodes.push_back(na);
+        nodes.push_back(nb);
+    }};
+
+    // long entrances get a transition at both ends, short ones in the middle
+    static constexpr i32 MaxShortEntrance {5};
+    for (i32 i {0}; i < length;) {
+        if (!isOpen(i)) {
+            ++i;
+            continue;
+        }
+
+        i32 const first {i};
+        while (i < length && isOpen(i)) { ++i; }
+        i32 const last {i - 1};
+
+        if (last - first + 1 <= MaxShortEntrance) {
+            addEntrance((first + last) / 2, 0);
+        } else {
+            addEntrance(first, 0);
+            addEntrance(last, 0);
+        }
+    }
+
+    if (!_allowDiagonal) { return; }
+
+    // a diagonal crossing next to a straight one is covered by its entrance, all others get their own
+    for (i32 i {0}; i < length - 1; ++i) {
+        if (isOpen(i) || isOpen(i + 1)) { continue; }
+        if (canCross(inner(i), outer(i + 1))) { addEntrance(i, 1); }
+        if (canCross(inner(i + 1), outer(i))) { addEntrance(i + 1, -1); }
+    }
+
+    // diagonal steps through the bottom corners lead into the diagonal neighbors
+    if (!vertical) {
+        if (canCross(inner(0), outer(-1))) { addEntrance(0, -1); }
+        if (canCross(inner(length - 1), outer(length))) { addEntrance(length - 1, 1); }
+    }
+}
+
+void hpa_pathfinding::build_edges(AStarGrid auto&& testGrid, i32 clusterIdx)
+{
+    for (i32 const from : _clusters[static_cast<usize>(clusterIdx)].Nodes) {
+        auto& fromNode {_nodes[static_cast<usize>(from)]};
+        local_costs(testGrid, clusterIdx, fromNode.Position, false, fromNode.Edges);
+        std::erase_if(fromNode.Edges, [from](edge const& e) { return e.Target == from; });
+    }
+}
+
+void hpa_pathfinding::local_costs(AStarGrid auto&& testGrid, i32 clusterIdx, point_i source, bool reverse, std::vector<edge>& edges)
+{
+    auto const& cl {_clusters[static_cast<usize>(clusterIdx)]};
+    auto const& bounds {cl.Bounds};
+    point_i const offset {bounds.top_left()};
+
+    edges.clear();
+    if (cl.Nodes.empty()) { return; }
+
+    auto& ctx {_localContext};
+    ctx.prepare(bounds.Size);
+
+    // mark the node cells, so the search can stop once all of them are settled
+    _targetCells.assign(static_cast<usize>(bounds.width() * bounds.height()), 0);
+    usize remaining {0};
+    for (i32 const n : cl.Nodes) {
+        auto& cell {_targetCells[static_cast<usize>(ctx.index_of(_nodes[static_cast<usize>(n)].Position - offset))]};
+        if (cell == 0) { ++remaining; }
+        cell = 1;
+    }
+
+    // Dijkstra from one cell to all nodes of the cluster
+    i32 const sourceIdx {ctx.index_of(source - offset)};
+    ctx.open(sourceIdx, 0, sourceIdx);
+    ctx.heap_push({.Score = 0, .Index = sourceIdx});
+
+    while (!ctx.heap_empty() && remaining > 0) {
+        i32 const currentIdx {ctx.heap_pop().Index};
+        if (ctx.is_closed(currentIdx)) { continue; }
+        ctx.close(currentIdx);
+        if (_targetCells[static_cast<usize>(currentIdx)]) { --remaining; }
+
+        point_i const current {ctx.position_of(currentIdx)};
+        for (i32 dy {-1}; dy <= 1; ++dy) {
+            for (i32 dx {-1}; dx <= 1; ++dx) {
+                if (dx == 0 && dy == 0) { continue; }
+                if (!_allowDiagonal && dx != 0 && dy != 0) { continue; }
+
+                point_i const neighbor {current.X + dx, current.Y + dy};
+                if (neighbor.X < 0 || neighbor.X >= bounds.width() || neighbor.Y < 0 || neighbor.Y >= bounds.height()) { continue; }
+
+                u64 const cost {reverse ? testGrid.get_cost(neighbor + offset, current + offset) : testGrid.get_cost(current + offset, neighbor + offset)};
+                if (cost == astar_pathfinding::IMPASSABLE_COST) { continue; }
+
+                i32 const neighborIdx {ctx.index_of(neighbor)};
+                u64 const tentative_gScore {ctx.get_score(currentIdx) + cost};
+                if (tentative_gScore < ctx.get_score(neighborIdx)) {
+                    ctx.open(neighborIdx, tentative_gScore, currentIdx);
+                    ctx.heap_push({.Score = tentative_gScore, .Index = neighborIdx});
+                }
+            }
+        }
+    }
+
+    for (i32 const n : cl.Nodes) {
+        i32 const idx {ctx.index_of(_nodes[static_cast<usize>(n)].Position - offset)};
+        if (ctx.is_closed(idx)) { edges.push_back({.Target = n, .Cost = ctx.get_score(idx)}); }
+    }
+}
+
+auto hpa_pathfinding::find_local_path(AStarGrid auto&& testGrid, rect_i const& bounds, point_i start, point_i finish) -> std::vector<point_i>
+{
+    point_i const offset {bounds.top_left()};
+
+    detail::cluster_grid<std::remove_reference_t<decltype(testGrid)>> const localGrid {.Grid = testGrid, .Offset = offset};
+
+    auto retValue {_local.find_path(_localContext, localGrid, bounds.Size, start - offset, finish - offset)};
+    for (auto& p : retValue) { p += offset; }
+    return retValue;
+}
+
+auto hpa_pathfinding::path_cost(AStarGrid auto&& testGrid, point_i start, std::vector<point_i> const& path) const -> u64
+{
+    u64     retValue {0};
+    point_i prev {start};
+    for (auto const& p : path) {
+        retValue += testGrid.get_cost(prev, p);
+        prev = p;
+    }
+    return retValue;
+}
+
 }
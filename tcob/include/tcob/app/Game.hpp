@@ -13,6 +13,7 @@
 #include "tcob/app/Scene.hpp"
 #include "tcob/core/Interfaces.hpp"
 #include "tcob/core/Signal.hpp"
+#include "tcob/core/TaskManager.hpp"
 #include "tcob/core/assets/AssetLibrary.hpp"
 #include "tcob/core/input/Input.hpp"
 #include "tcob/data/ConfigTypes.hpp"
@@ -25,12 +26,13 @@ namespace tcob {
 class TCOB_API game : public non_copyable {
 public:
     struct init {
-        path                        Name {};                      //!< The name of the game.
-        path                        OrgName {"tcob"};             //!< The organization name.
-        path                        LogFile {"tcob.log"};         //!< The log file name.
-        path                        ConfigFile {"config.ini"};    //!< The configuration file name.
+        path                        Name {};                              //!< The name of the game.
+        path                        OrgName {"tcob"};                     //!< The organization name.
+        path                        LogFile {"tcob.log"};                 //!< The log file name.
+        path                        ConfigFile {"config.ini"};            //!< The configuration file name.
         std::optional<data::object> ConfigDefaults {std::nullopt};
-        std::optional<isize>        WorkerThreads {std::nullopt}; //!< The number of concurrent asynchronous threads.
+        std::optional<isize>        WorkerThreads {std::nullopt};         //!< The number of concurrent asynchronous threads.
+        task_scheduling             Scheduling {task_scheduling::Shared}; //!< The task scheduling strategy of the worker threads.
     };
 
     explicit game(init const& gameInit);
@@ -58,7 +58,7 @@ protected:
     static void InitImageCodecs();
     static void InitAudioCodecs();
     static void InitFontEngines();
-    static void InitTaskManager(std::optional<isize> workerThreads);
+    static void InitTaskManager(std::optional<isize> workerThreads, task_scheduling scheduling);
 
 private:
     void remove_services() const;
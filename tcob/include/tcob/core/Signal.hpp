@@ -6,7 +6,11 @@
 #pragma once
 #include "tcob/tcob_config.hpp"
 
-#include <functional>
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -65,9 +69,73 @@ namespace detail {
         virtual ~signal_base() = default;
 
         virtual void disconnect(uid id) const = 0;
+    };
+
+    ////////////////////////////////////////////////////////////
+
+    // move-only delegate, callables up to BufferSize bytes are stored inline
+    template <typename Signature, usize BufferSize = 4 * sizeof(void*)>
+    class small_function;
+
+    template <typename R, typename... Args, usize BufferSize>
+    class small_function<R(Args...), BufferSize> final {
+    public:
+        small_function() = default;
+        template <typename Func>
+            requires(!std::is_same_v<std::remove_cvref_t<Func>, small_function> && std::is_invocable_r_v<R, std::remove_cvref_t<Func>&, Args...>)
+        small_function(Func&& func);
+        small_function(small_function const& other)                    = delete;
+        auto operator=(small_function const& other) -> small_function& = delete;
+        small_function(small_function&& other) noexcept;
+        auto operator=(small_function&& other) noexcept -> small_function&;
+        ~small_function();
+
+        explicit operator bool() const;
+
+        auto operator()(Args... args) const -> R;
+
+        void reset();
 
-    protected:
-        auto next_id() const -> uid;
+    private:
+        struct vtable {
+            R (*Invoke)(void* storage, Args&&... args);
+            void (*Move)(void* dst, void* src);
+            void (*Destroy)(void* storage);
+        };
+
+        template <typename Func>
+        static constexpr bool IsInline {sizeof(Func) <= BufferSize && alignof(Func) <= alignof(std::max_align_t) && std::is_nothrow_move_constructible_v<Func>};
+
+        template <typename Func>
+        static auto GetVTable() -> vtable const*;
+
+        alignas(std::max_align_t) mutable std::byte _storage[BufferSize];
+        vtable const* _vtable {nullptr};
+    };
+
+    ////////////////////////////////////////////////////////////
+
+    template <typename EvArgs>
+    struct signal_traits {
+        static constexpr bool IsVoid {std::is_void_v<std::remove_cvref_t<EvArgs>>};
+
+        template <typename T, bool IsVoid>
+        struct slot_func_type;
+
+        template <typename T>
+        struct slot_func_type<T, false> {
+            using type = small_function<void(T&)>;
+        };
+
+        template <typename T>
+        struct slot_func_type<T, true> {
+            using type = small_function<void()>;
+        };
+
+        using slot_func = typename slot_func_type<EvArgs, IsVoid>::type;
+
+        template <typename Func>
+        static auto wrap(Func func);
     };
 }
 
@@ -75,23 +143,81 @@ namespace detail {
 
 template <typename EvArgs = void>
 class signal final : public detail::signal_base {
-    static constexpr bool IsVoid {std::is_void_v<std::remove_cvref_t<EvArgs>>};
+    using traits = detail::signal_traits<EvArgs>;
+
+    static constexpr bool IsVoid {traits::IsVoid};
+
+    using slot_func = typename traits::slot_func;
 
-    template <typename T, bool IsVoid>
-    struct slot_func_type;
+    struct slot {
+        u32       Handle {0};
+        slot_func Func {};
+    };
 
-    template <typename T>
-    struct slot_func_type<T, false> {
-        using type = std::function<void(T&)>;
+    struct handle {
+        u32 Generation {0};
+        u32 Position {0}; // index into _slots, or _slots.size() + index into _pending
     };
 
-    template <typename T>
-    struct slot_func_type<T, true> {
-        using type = std::function<void()>;
+    static constexpr u32 DeadSlot {std::numeric_limits<u32>::max()};
+
+public:
+    void operator()() const
+        requires(IsVoid);
+
+    template <typename S = EvArgs>
+    void operator()(S&& args) const
+        requires(!IsVoid);
+
+    template <typename Func>
+    auto connect(Func func) const -> connection;
+    template <auto Func, typename T>
+    auto connect(T* inst) const -> connection;
+
+    void disconnect(uid id) const override;
+    void disconnect_all() const;
+
+    template <typename Func>
+    auto operator+=(Func func) const -> connection;
+
+    auto operator-=(connection& c) const -> void;
+    auto operator-=(uid c) const -> void;
+
+    auto slot_count() const -> isize;
+
+private:
+    struct emit_scope {
+        explicit emit_scope(signal const& sig);
+        ~emit_scope();
+
+        signal const& Signal;
     };
 
-    using slot_func = typename slot_func_type<EvArgs, IsVoid>::type;
-    using slots     = std::vector<std::pair<uid, slot_func>>;
+    void kill_slot(handle& h) const;
+    void compact() const;
+
+    // slots in connection order; disconnected slots stay as empty functions until compaction
+    mutable std::vector<slot>   _slots;
+    mutable std::vector<slot>   _pending; // connected during emission
+    mutable std::vector<handle> _handles;
+    mutable std::vector<u32>    _freeHandles;
+    mutable isize               _liveCount {0};
+    mutable isize               _deadCount {0};
+    mutable i32                 _emitDepth {0};
+};
+
+////////////////////////////////////////////////////////////
+
+//! Thread-safe signal: emission works on an immutable snapshot of the
+//! slots, connect and disconnect publish a new snapshot (RCU-style).
+template <typename EvArgs = void>
+class concurrent_signal final : public detail::signal_base {
+    using traits = detail::signal_traits<EvArgs>;
+
+    static constexpr bool IsVoid {traits::IsVoid};
+
+    using slot_func = typename traits::slot_func;
+    using slots     = std::vector<std::pair<uid, std::shared_ptr<slot_func const>>>;
 
 public:
     void operator()() const
@@ -118,7 +244,13 @@ public:
     auto slot_count() const -> isize;
 
 private:
-    mutable slots _slots;
+    auto snapshot() const -> std::shared_ptr<slots const>;
+    void publish(std::shared_ptr<slots const> slots) const;
+
+    mutable std::shared_ptr<slots const> _slots {std::make_shared<slots const>()};
+    mutable std::mutex                   _snapshotMutex;
+    mutable std::mutex                   _writeMutex;
+    mutable std::atomic<uid>             _nextID {1};
 };
 
 ////////////////////////////////////////////////////////////
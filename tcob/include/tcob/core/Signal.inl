@@ -6,19 +6,160 @@
 #pragma once
 #include "Signal.hpp"
 
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+
 namespace tcob {
 
+namespace detail {
+
+    template <typename R, typename... Args, usize BufferSize>
+    template <typename Func>
+        requires(!std::is_same_v<std::remove_cvref_t<Func>, small_function<R(Args...), BufferSize>> && std::is_invocable_r_v<R, std::remove_cvref_t<Func>&, Args...>)
+    inline small_function<R(Args...), BufferSize>::small_function(Func&& func)
+    {
+        using F = std::remove_cvref_t<Func>;
+        if constexpr (IsInline<F>) {
+            ::new (static_cast<void*>(_storage)) F(std::forward<Func>(func));
+        } else {
+            ::new (static_cast<void*>(_storage)) F*(new F(std::forward<Func>(func)));
+        }
+        _vtable = GetVTable<F>();
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline small_function<R(Args...), BufferSize>::small_function(small_function&& other) noexcept
+        : _vtable {other._vtable}
+    {
+        if (_vtable) {
+            _vtable->Move(_storage, other._storage);
+            other._vtable = nullptr;
+        }
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline auto small_function<R(Args...), BufferSize>::operator=(small_function&& other) noexcept -> small_function&
+    {
+        if (this != &other) {
+            reset();
+            if (other._vtable) {
+                other._vtable->Move(_storage, other._storage);
+                _vtable = std::exchange(other._vtable, nullptr);
+            }
+        }
+        return *this;
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline small_function<R(Args...), BufferSize>::~small_function()
+    {
+        reset();
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline small_function<R(Args...), BufferSize>::operator bool() const
+    {
+        return _vtable != nullptr;
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline auto small_function<R(Args...), BufferSize>::operator()(Args... args) const -> R
+    {
+        assert(_vtable);
+        return _vtable->Invoke(_storage, std::forward<Args>(args)...);
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    inline void small_function<R(Args...), BufferSize>::reset()
+    {
+        if (_vtable) {
+            _vtable->Destroy(_storage);
+            _vtable = nullptr;
+        }
+    }
+
+    template <typename R, typename... Args, usize BufferSize>
+    template <typename Func>
+    inline auto small_function<R(Args...), BufferSize>::GetVTable() -> vtable const*
+    {
+        if constexpr (IsInline<Func>) {
+            static constexpr vtable table {
+                .Invoke  = [](void* storage, Args&&... args) -> R { return std::invoke(*static_cast<Func*>(storage), std::forward<Args>(args)...); },
+                .Move    = [](void* dst, void* src) {
+                    ::new (dst) Func(std::move(*static_cast<Func*>(src)));
+                    static_cast<Func*>(src)->~Func();
+                },
+                .Destroy = [](void* storage) { static_cast<Func*>(storage)->~Func(); }};
+            return &table;
+        } else {
+            static constexpr vtable table {
+                .Invoke  = [](void* storage, Args&&... args) -> R { return std::invoke(**static_cast<Func**>(storage), std::forward<Args>(args)...); },
+                .Move    = [](void* dst, void* src) { ::new (dst) Func*(*static_cast<Func**>(src)); },
+                .Destroy = [](void* storage) { delete *static_cast<Func**>(storage); }};
+            return &table;
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    template <typename EvArgs>
+    template <typename Func>
+    inline auto signal_traits<EvArgs>::wrap(Func func)
+    {
+        if constexpr (IsVoid) {
+            if constexpr (std::is_invocable_v<Func&>) {
+                return func;
+            }
+        } else {
+            if constexpr (std::is_invocable_v<Func&, EvArgs&>) {
+                return func;
+            } else {
+                return [func](EvArgs&) mutable { std::invoke(func); };
+            }
+        }
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+template <typename EvArgs>
+inline signal<EvArgs>::emit_scope::emit_scope(signal const& sig)
+    : Signal {sig}
+{
+    ++Signal._emitDepth;
+}
+
+template <typename EvArgs>
+inline signal<EvArgs>::emit_scope::~emit_scope()
+{
+    if (--Signal._emitDepth > 0) { return; }
+
+    // slots connected during emission keep their positions: they were numbered after _slots
+    if (!Signal._pending.empty()) {
+        for (auto& slot : Signal._pending) { Signal._slots.push_back(std::move(slot)); }
+        Signal._pending.clear();
+    }
+    if (Signal._deadCount > 0) { Signal.compact(); }
+}
+
 template <typename EvArgs>
 inline void signal<EvArgs>::operator()() const
     requires(IsVoid)
 {
-    for (auto it {_slots.begin()}; it != _slots.end();) {
-        if (it->second) {
-            it->second();
-            ++it;
-        } else {
-            it = _slots.erase(it);
-        }
+    emit_scope const scope {*this};
+
+    usize const count {_slots.size()};
+    for (usize i {0}; i < count; ++i) {
+        auto const& slot {_slots[i]};
+        if (slot.Handle == DeadSlot) { continue; }
+        slot.Func();
     }
 }
 
@@ -27,16 +168,16 @@ template <typename S>
 inline void signal<EvArgs>::operator()(S&& args) const
     requires(!IsVoid)
 {
-    for (auto it {_slots.begin()}; it != _slots.end();) {
-        if (it->second) {
-            if constexpr (requires { args.Handled; }) {
-                if (args.Handled) { break; }
-            }
-            it->second(std::forward<S>(args));
-            ++it;
-        } else {
-            it = _slots.erase(it);
+    emit_scope const scope {*this};
+
+    usize const count {_slots.size()};
+    for (usize i {0}; i < count; ++i) {
+        auto const& slot {_slots[i]};
+        if (slot.Handle == DeadSlot) { continue; }
+        if constexpr (requires { args.Handled; }) {
+            if (args.Handled) { break; }
         }
+        slot.Func(std::forward<S>(args));
     }
 }
 
@@ -44,17 +185,27 @@ template <typename EvArgs>
 template <typename Func>
 inline auto signal<EvArgs>::connect(Func func) const -> connection
 {
-    if constexpr (std::is_convertible_v<Func, slot_func>) {
-        uid const id {next_id()};
-        _slots.emplace_back(id, func);
-        return connection {this, id};
+    u32 handleIdx {0};
+    if (_freeHandles.empty()) {
+        handleIdx = static_cast<u32>(_handles.size());
+        _handles.push_back({.Generation = 1, .Position = 0});
     } else {
-        if constexpr (IsVoid) {
-            return connect([func] { func(); });
-        } else {
-            return connect([func](EvArgs&) { func(); });
-        }
+        handleIdx = _freeHandles.back();
+        _freeHandles.pop_back();
     }
+
+    auto& h {_handles[handleIdx]};
+    if (_emitDepth > 0) {
+        // don't touch _slots while it is iterated
+        h.Position = static_cast<u32>(_slots.size() + _pending.size());
+        _pending.push_back({.Handle = handleIdx, .Func = traits::wrap(std::move(func))});
+    } else {
+        h.Position = static_cast<u32>(_slots.size());
+        _slots.push_back({.Handle = handleIdx, .Func = traits::wrap(std::move(func))});
+    }
+    ++_liveCount;
+
+    return connection {this, static_cast<uid>((static_cast<u64>(h.Generation) << 32) | handleIdx)};
 }
 
 template <typename EvArgs>
@@ -71,18 +222,38 @@ inline auto signal<EvArgs>::connect(T* inst) const -> connection
 template <typename EvArgs>
 inline void signal<EvArgs>::disconnect(uid id) const
 {
-    for (auto it {_slots.begin()}; it != _slots.end(); ++it) {
-        if (it->first == id) {
-            _slots.erase(it);
-            return;
-        }
-    }
+    if (id < 0) { return; }
+
+    u32 const handleIdx {static_cast<u32>(static_cast<u64>(id) & 0xFFFFFFFF)};
+    u32 const generation {static_cast<u32>(static_cast<u64>(id) >> 32)};
+    if (handleIdx >= _handles.size() || _handles[handleIdx].Generation != generation) { return; }
+
+    kill_slot(_handles[handleIdx]);
+    _freeHandles.push_back(handleIdx);
+
+    if (_emitDepth == 0 && _deadCount * 2 > std::ssize(_slots)) { compact(); }
 }
 
 template <typename EvArgs>
 inline void signal<EvArgs>::disconnect_all() const
 {
-    _slots.clear();
+    if (_emitDepth == 0) {
+        _slots.clear();
+        _pending.clear();
+        _deadCount = 0;
+    } else {
+        for (auto& slot : _slots) { slot.Handle = DeadSlot; }
+        for (auto& slot : _pending) { slot.Handle = DeadSlot; }
+        _deadCount = std::ssize(_slots) + std::ssize(_pending);
+    }
+
+    _freeHandles.clear();
+    for (u32 i {0}; i < _handles.size(); ++i) {
+        auto& h {_handles[i]};
+        h.Generation = h.Generation == std::numeric_limits<i32>::max() ? 1 : h.Generation + 1;
+        _freeHandles.push_back(i);
+    }
+    _liveCount = 0;
 }
 
 template <typename EvArgs>
@@ -107,7 +278,151 @@ inline auto signal<EvArgs>::operator-=(uid c) const -> void
 template <typename EvArgs>
 inline auto signal<EvArgs>::slot_count() const -> isize
 {
-    return std::ssize(_slots);
+    return _liveCount;
+}
+
+template <typename EvArgs>
+inline void signal<EvArgs>::kill_slot(handle& h) const
+{
+    usize const pos {h.Position};
+    auto&       slot {pos < _slots.size() ? _slots[pos] : _pending[pos - _slots.size()]};
+
+    // a running slot may disconnect itself, so functions are only destroyed outside of emission
+    slot.Handle = DeadSlot;
+    if (_emitDepth == 0) { slot.Func.reset(); }
+
+    // generations stay positive, so ids never collide with INVALID_ID
+    h.Generation = h.Generation == std::numeric_limits<i32>::max() ? 1 : h.Generation + 1;
+
+    --_liveCount;
+    ++_deadCount;
+}
+
+template <typename EvArgs>
+inline void signal<EvArgs>::compact() const
+{
+    usize dst {0};
+    for (usize src {0}; src < _slots.size(); ++src) {
+        if (_slots[src].Handle == DeadSlot) { continue; }
+        if (dst != src) { _slots[dst] = std::move(_slots[src]); }
+        _handles[_slots[dst].Handle].Position = static_cast<u32>(dst);
+        ++dst;
+    }
+    _slots.erase(_slots.begin() + static_cast<isize>(dst), _slots.end());
+    _deadCount = 0;
+}
+
+////////////////////////////////////////////////////////////
+
+template <typename EvArgs>
+inline void concurrent_signal<EvArgs>::operator()() const
+    requires(IsVoid)
+{
+    auto const slots {snapshot()};
+    for (auto const& [id, func] : *slots) {
+        (*func)();
+    }
+}
+
+template <typename EvArgs>
+template <typename S>
+inline void concurrent_signal<EvArgs>::operator()(S&& args) const
+    requires(!IsVoid)
+{
+    auto const slots {snapshot()};
+    for (auto const& [id, func] : *slots) {
+        if constexpr (requires { args.Handled; }) {
+            if (args.Handled) { break; }
+        }
+        (*func)(std::forward<S>(args));
+    }
+}
+
+template <typename EvArgs>
+template <typename Func>
+inline auto concurrent_signal<EvArgs>::connect(Func func) const -> connection
+{
+    uid const id {_nextID.fetch_add(1, std::memory_order_relaxed)};
+    auto      slotFunc {std::make_shared<slot_func const>(traits::wrap(std::move(func)))};
+
+    std::scoped_lock lock {_writeMutex};
+    auto             newSlots {std::make_shared<slots>(*snapshot())};
+    newSlots->emplace_back(id, std::move(slotFunc));
+    publish(std::move(newSlots));
+
+    return connection {this, id};
+}
+
+template <typename EvArgs>
+template <auto Func, typename T>
+inline auto concurrent_signal<EvArgs>::connect(T* inst) const -> connection
+{
+    if constexpr (IsVoid) {
+        return connect([inst] { (inst->*Func)(); });
+    } else {
+        return connect([inst](EvArgs& args) { (inst->*Func)(args); });
+    }
+}
+
+template <typename EvArgs>
+inline void concurrent_signal<EvArgs>::disconnect(uid id) const
+{
+    std::scoped_lock lock {_writeMutex};
+    auto const       current {snapshot()};
+    if (std::ranges::none_of(*current, [id](auto const& slot) { return slot.first == id; })) { return; }
+
+    auto newSlots {std::make_shared<slots>()};
+    newSlots->reserve(current->size() - 1);
+    for (auto const& slot : *current) {
+        if (slot.first != id) { newSlots->push_back(slot); }
+    }
+    publish(std::move(newSlots));
+}
+
+template <typename EvArgs>
+inline void concurrent_signal<EvArgs>::disconnect_all() const
+{
+    std::scoped_lock lock {_writeMutex};
+    publish(std::make_shared<slots const>());
+}
+
+template <typename EvArgs>
+template <typename Func>
+inline auto concurrent_signal<EvArgs>::operator+=(Func func) const -> connection
+{
+    return connect(std::move(func));
+}
+
+template <typename EvArgs>
+inline auto concurrent_signal<EvArgs>::operator-=(connection& c) const -> void
+{
+    c.disconnect();
+}
+
+template <typename EvArgs>
+inline auto concurrent_signal<EvArgs>::operator-=(uid c) const -> void
+{
+    disconnect(c);
+}
+
+template <typename EvArgs>
+inline auto concurrent_signal<EvArgs>::slot_count() const -> isize
+{
+    return std::ssize(*snapshot());
+}
+
+template <typename EvArgs>
+inline auto concurrent_signal<EvArgs>::snapshot() const -> std::shared_ptr<slots const>
+{
+    std::scoped_lock lock {_snapshotMutex};
+    return _slots;
+}
+
+template <typename EvArgs>
+inline void concurrent_signal<EvArgs>::publish(std::shared_ptr<slots const> slots) const
+{
+    std::scoped_lock lock {_snapshotMutex};
+    _slots = std::move(slots);
 }
 
 ////////////////////////////////////////////////////////////
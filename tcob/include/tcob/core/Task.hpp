@@ -0,0 +1,108 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <exception>
+#include <optional>
+
+namespace tcob {
+////////////////////////////////////////////////////////////
+
+template <typename T>
+class task;
+
+namespace detail {
+    ////////////////////////////////////////////////////////////
+
+    class task_promise_base {
+    public:
+        struct final_awaiter {
+            auto await_ready() const noexcept -> bool { return false; }
+            template <typename Promise>
+            auto await_suspend(std::coroutine_handle<Promise> handle) const noexcept -> std::coroutine_handle<>;
+            void await_resume() const noexcept { }
+        };
+
+        auto initial_suspend() const noexcept -> std::suspend_never { return {}; }
+        auto final_suspend() const noexcept -> final_awaiter { return {}; }
+        void unhandled_exception() noexcept { _exception = std::current_exception(); }
+
+        auto is_done() const -> bool;
+        auto set_continuation(std::coroutine_handle<> continuation) -> bool;
+        auto release() -> bool;
+
+        void rethrow_if_exception() const;
+
+    private:
+        // nullptr: running, this: finished, otherwise the awaiting coroutine
+        std::atomic<void*> _continuation {nullptr};
+        // shared by the task object and the running coroutine
+        std::atomic<i32>   _refCount {2};
+        std::exception_ptr _exception {};
+    };
+
+    ////////////////////////////////////////////////////////////
+
+    template <typename T>
+    class task_promise final : public task_promise_base {
+    public:
+        auto get_return_object() -> task<T>;
+
+        void return_value(T value);
+        auto result() -> T&;
+
+    private:
+        std::optional<T> _value {};
+    };
+
+    template <>
+    class task_promise<void> final : public task_promise_base {
+    public:
+        auto get_return_object() -> task<void>;
+
+        void return_void() const { }
+        void result() const;
+    };
+}
+
+////////////////////////////////////////////////////////////
+
+//! Eagerly started coroutine. The coroutine keeps running when the
+//! task object is destroyed; awaiting the task resumes the awaiting
+//! coroutine once the result is available.
+template <typename T = void>
+class [[nodiscard]] task final {
+public:
+    using promise_type = detail::task_promise<T>;
+    using handle_type  = std::coroutine_handle<promise_type>;
+
+    task() = default;
+    explicit task(handle_type handle);
+    task(task const& other) noexcept                    = delete;
+    auto operator=(task const& other) noexcept -> task& = delete;
+    task(task&& other) noexcept;
+    auto operator=(task&& other) noexcept -> task&;
+    ~task();
+
+    auto is_valid() const -> bool;
+    auto is_done() const -> bool;
+
+    auto get() -> decltype(auto);
+
+    auto operator co_await() && noexcept;
+
+private:
+    void reset();
+
+    handle_type _handle {};
+};
+
+}
+
+#include "Task.inl"
@@ -0,0 +1,163 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "Task.hpp"
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+namespace tcob {
+
+namespace detail {
+
+    template <typename Promise>
+    inline auto task_promise_base::final_awaiter::await_suspend(std::coroutine_handle<Promise> handle) const noexcept -> std::coroutine_handle<>
+    {
+        auto&       promise {handle.promise()};
+        void* const continuation {promise._continuation.exchange(&promise, std::memory_order_acq_rel)};
+        if (promise.release()) { handle.destroy(); }
+
+        return continuation ? std::coroutine_handle<>::from_address(continuation) : std::noop_coroutine();
+    }
+
+    inline auto task_promise_base::is_done() const -> bool
+    {
+        return _continuation.load(std::memory_order_acquire) == this;
+    }
+
+    inline auto task_promise_base::set_continuation(std::coroutine_handle<> continuation) -> bool
+    {
+        void* expected {nullptr};
+        return _continuation.compare_exchange_strong(expected, continuation.address(), std::memory_order_acq_rel);
+    }
+
+    inline auto task_promise_base::release() -> bool
+    {
+        return _refCount.fetch_sub(1, std::memory_order_acq_rel) == 1;
+    }
+
+    inline void task_promise_base::rethrow_if_exception() const
+    {
+        if (_exception) { std::rethrow_exception(_exception); }
+    }
+
+    ////////////////////////////////////////////////////////////
+
+    template <typename T>
+    inline auto task_promise<T>::get_return_object() -> task<T>
+    {
+        return task<T> {std::coroutine_handle<task_promise<T>>::from_promise(*this)};
+    }
+
+    template <typename T>
+    inline void task_promise<T>::return_value(T value)
+    {
+        _value = std::move(value);
+    }
+
+    template <typename T>
+    inline auto task_promise<T>::result() -> T&
+    {
+        rethrow_if_exception();
+        return *_value;
+    }
+
+    inline auto task_promise<void>::get_return_object() -> task<void>
+    {
+        return task<void> {std::coroutine_handle<task_promise<void>>::from_promise(*this)};
+    }
+
+    inline void task_promise<void>::result() const
+    {
+        rethrow_if_exception();
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+template <typename T>
+inline task<T>::task(handle_type handle)
+    : _handle {handle}
+{
+}
+
+template <typename T>
+inline task<T>::task(task&& other) noexcept
+    : _handle {std::exchange(other._handle, nullptr)}
+{
+}
+
+template <typename T>
+inline auto task<T>::operator=(task&& other) noexcept -> task&
+{
+    if (this != &other) {
+        reset();
+        _handle = std::exchange(other._handle, nullptr);
+    }
+    return *this;
+}
+
+template <typename T>
+inline task<T>::~task()
+{
+    reset();
+}
+
+template <typename T>
+inline auto task<T>::is_valid() const -> bool
+{
+    return static_cast<bool>(_handle);
+}
+
+template <typename T>
+inline auto task<T>::is_done() const -> bool
+{
+    return _handle && _handle.promise().is_done();
+}
+
+template <typename T>
+inline auto task<T>::get() -> decltype(auto)
+{
+    assert(is_done());
+    return _handle.promise().result();
+}
+
+template <typename T>
+inline auto task<T>::operator co_await() && noexcept
+{
+    struct awaiter {
+        handle_type Handle;
+
+        auto await_ready() const -> bool { return Handle.promise().is_done(); }
+        auto await_suspend(std::coroutine_handle<> continuation) const -> bool
+        {
+            // false: the task finished in the meantime, continue right away
+            return Handle.promise().set_continuation(continuation);
+        }
+        auto await_resume() const -> decltype(auto)
+        {
+            if constexpr (std::is_void_v<T>) {
+                Handle.promise().result();
+            } else {
+                return std::move(Handle.promise().result());
+            }
+        }
+    };
+
+    assert(_handle);
+    return awaiter {_handle};
+}
+
+template <typename T>
+inline void task<T>::reset()
+{
+    if (_handle && _handle.promise().release()) { _handle.destroy(); }
+    _handle = nullptr;
+}
+
+}
@@ -6,10 +6,16 @@
 #pragma once
 #include "tcob/tcob_config.hpp"
 
+#include <atomic>
 #include <condition_variable>
+#include <coroutine>
 #include <deque>
+#include <exception>
 #include <functional>
 #include <future>
+#include <latch>
+#include <limits>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <stop_token>
@@ -20,6 +26,19 @@
 namespace tcob {
 ////////////////////////////////////////////////////////////
 
+namespace detail {
+    class work_stealing_queue;
+}
+
+////////////////////////////////////////////////////////////
+
+enum class task_scheduling : u8 {
+    Shared,      //!< All workers share one locked queue.
+    WorkStealing //!< Each worker owns a lock-free deque and steals from random victims when idle.
+};
+
+////////////////////////////////////////////////////////////
+
 struct par_task {
     isize Start {0};
     isize End {0};
@@ -35,6 +54,47 @@ struct def_task {
 
 ////////////////////////////////////////////////////////////
 
+class TCOB_API task_graph final {
+    friend class task_manager;
+
+public:
+    using node_func = std::function<void()>;
+
+    static constexpr usize INVALID_NODE {std::numeric_limits<usize>::max()};
+
+    auto add_node(string const& name, node_func const& func) -> usize;
+    void add_dependency(usize node, usize dependsOn); //!< node runs after dependsOn has finished
+
+    void clear();
+
+    auto node_count() const -> usize;
+
+    auto trace_json() const -> string; //!< timings of the last run in Chrome trace event format
+
+private:
+    auto is_acyclic() const -> bool;
+
+    struct node {
+        string             Name;
+        node_func          Func;
+        std::vector<usize> Successors {};
+        isize              Dependencies {0};
+
+        f64   Start {0};
+        f64   Duration {0};
+        isize Thread {0};
+    };
+
+    std::vector<node>                     _nodes;
+    std::vector<usize>                    _roots;
+    std::unique_ptr<std::atomic<isize>[]> _pending;
+    usize                                 _pendingSize {0};
+    bool                                  _isChanged {true};
+    bool                                  _isAcyclic {true};
+};
+
+////////////////////////////////////////////////////////////
+
 class TCOB_API task_manager final {
     friend class game; // loop -> process_queue
     using task_func = std::function<void()>;
@@ -45,18 +105,52 @@ public:
     using par_func   = std::function<void(par_task const&)>;
     using def_func   = std::function<void(def_task const&)>;
 
-    explicit task_manager(isize threads);
+    struct worker_awaitable {
+        task_manager* Manager;
+
+        auto await_ready() const noexcept -> bool;
+        void await_suspend(std::coroutine_handle<> handle) const;
+        void await_resume() const noexcept { }
+    };
+
+    struct main_awaitable {
+        task_manager* Manager;
+
+        auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const;
+        void await_resume() const noexcept { }
+    };
+
+    struct delay_awaitable {
+        task_manager* Manager;
+        milliseconds  Delay;
+
+        auto await_ready() const noexcept -> bool { return false; }
+        void await_suspend(std::coroutine_handle<> handle) const;
+        void await_resume() const noexcept { }
+    };
+
+    explicit task_manager(isize threads, task_scheduling scheduling = task_scheduling::Shared);
     ~task_manager();
 
     template <typename T>
     auto run_async(async_func<T> const& func) -> std::future<T>;
 
     void run_parallel(par_func const& func, isize count, isize minRange = 1);
+    void run_detached(std::function<void()> func); //!< fire and forget, the caller has to track completion itself
+
+    auto run_graph(task_graph& graph) -> bool; //!< rethrows the first exception thrown by a node, nodes not started by then are skipped
 
     auto run_deferred(def_func const& func) -> uid;
     void drop_deferred(uid id);
 
+    auto resume_on_worker() -> worker_awaitable;              //!< co_await: continue on a worker thread
+    auto resume_on_main() -> main_awaitable;                  //!< co_await: continue on the main thread with the next queue update
+    auto resume_after(milliseconds delay) -> delay_awaitable; //!< co_await: continue on the main thread after the given game time
+
     auto thread_count() const -> isize;
+    auto scheduling() const -> task_scheduling;
+    auto current_worker() const -> isize; //!< index of the calling worker thread, -1 on any other thread
 
     static inline char const* ServiceName {"task_manager"};
 
@@ -65,9 +159,52 @@ private:
 
     auto process_queue(milliseconds deltaTime, bool abort) -> bool;
 
-    void worker_thread(std::stop_token const& stopToken);
+    void worker_thread(std::stop_token const& stopToken, isize index);
+    void work_stealing_thread(std::stop_token const& stopToken, isize index);
+
+    struct parallel_run {
+        parallel_run(par_func const& func, isize count, isize minRange, isize threads)
+            : Func {&func}
+            , Count {count}
+            , MinRange {minRange}
+            , Threads {threads}
+        {
+        }
+
+        par_func const*    Func;
+        isize              Count;
+        isize              MinRange;
+        isize              Threads;
+        std::atomic<isize> Cursor {0};
+        std::atomic<isize> Done {0}; //!< number of finished items
+    };
+
+    static void run_parallel_chunks(parallel_run& run, isize thread);
+
+    struct graph_run {
+        explicit graph_run(isize nodes)
+            : Start {clock::now()}
+            , Done {nodes}
+        {
+        }
+
+        clock::time_point  Start;
+        std::latch         Done;
+        std::atomic<bool>  Failed {false};
+        std::exception_ptr Exception {};
+
+        std::mutex         ReadyMutex {};
+        std::vector<usize> Ready {}; //!< nodes whose dependencies have finished, not yet started
+    };
+
+    void push_ready_node(task_graph& graph, usize node, std::shared_ptr<graph_run> const& run);
+    static auto pop_ready_node(graph_run& run) -> usize;
+    void run_graph_node(task_graph& graph, usize node, std::shared_ptr<graph_run> const& run);
+
+    auto try_run_task(isize index) -> bool;
 
     isize           _threadCount;
+    task_scheduling _scheduling;
     std::thread::id _mainThreadID;
 
     std::queue<task_func>       _taskQueue;
@@ -75,10 +212,15 @@ private:
     std::vector<std::jthread>   _taskWorkers;
     std::condition_variable_any _taskCondition;
 
+    std::vector<std::unique_ptr<detail::work_stealing_queue>> _localQueues;
+    std::atomic<isize>                                        _pendingTasks {0};
+    std::atomic<isize>                                        _sleepingWorkers {0};
+
     using deferred_queue = std::deque<std::pair<def_func, uid>>;
     deferred_queue       _deferredQueueFront {};
     deferred_queue       _deferredQueueBack {};
     std::recursive_mutex _deferredMutex {};
+    std::atomic<uid>     _nextDeferredID {1};
 };
 
 }
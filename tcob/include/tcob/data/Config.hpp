@@ -23,9 +23,48 @@ class entry;
 class array;
 class object;
 
-using cfg_array_entries  = std::vector<entry>;
-using cfg_object_entries = std::vector<std::pair<string, entry>>;
-using cfg_value          = std::variant<std::monostate, i64, f64, bool, utf8_string, array, object>;
+using cfg_array_entries = std::vector<entry>;
+using cfg_value         = std::variant<std::monostate, i64, f64, bool, utf8_string, array, object>;
+
+////////////////////////////////////////////////////////////
+
+// Key/value pairs in insertion order. Once an object reaches IndexThreshold
+// entries, lookups go through an open-addressing hash index instead of a
+// linear scan.
+class TCOB_API cfg_object_entries final {
+public:
+    using value_type     = std::pair<string, entry>;
+    using container_type = std::vector<value_type>;
+    using iterator       = container_type::iterator;
+    using const_iterator = container_type::const_iterator;
+
+    static constexpr usize IndexThreshold {16};
+
+    auto begin() -> iterator;
+    auto begin() const -> const_iterator;
+    auto end() -> iterator;
+    auto end() const -> const_iterator;
+
+    auto empty() const -> bool;
+    auto size() const -> usize;
+    auto capacity() const -> usize;
+    void reserve(usize cap);
+    void clear();
+
+    auto find(string_view key) -> iterator;
+    auto find(string_view key) const -> const_iterator;
+
+    void emplace_back(string_view key, entry const& ent);
+    void erase(string_view key);
+
+private:
+    auto find_index(string_view key) const -> usize;
+    void insert_index(usize index);
+    void rebuild_index();
+
+    container_type   _entries;
+    std::vector<u32> _index; //!< slots hold entry index + 1, 0 marks an empty slot
+};
 
 ////////////////////////////////////////////////////////////
 
@@ -30,6 +30,58 @@ namespace tcob::data {
 
 ////////////////////////////////////////////////////////////
 
+inline auto cfg_object_entries::begin() -> iterator
+{
+    return _entries.begin();
+}
+
+inline auto cfg_object_entries::begin() const -> const_iterator
+{
+    return _entries.begin();
+}
+
+inline auto cfg_object_entries::end() -> iterator
+{
+    return _entries.end();
+}
+
+inline auto cfg_object_entries::end() const -> const_iterator
+{
+    return _entries.end();
+}
+
+inline auto cfg_object_entries::empty() const -> bool
+{
+    return _entries.empty();
+}
+
+inline auto cfg_object_entries::size() const -> usize
+{
+    return _entries.size();
+}
+
+inline auto cfg_object_entries::capacity() const -> usize
+{
+    return _entries.capacity();
+}
+
+inline void cfg_object_entries::reserve(usize cap)
+{
+    _entries.reserve(cap);
+}
+
+inline auto cfg_object_entries::find(string_view key) -> iterator
+{
+    return _entries.begin() + static_cast<isize>(find_index(key));
+}
+
+inline auto cfg_object_entries::find(string_view key) const -> const_iterator
+{
+    return _entries.begin() + static_cast<isize>(find_index(key));
+}
+
+////////////////////////////////////////////////////////////
+
 template <typename Impl, typename Container>
 inline base_type<Impl, Container>::base_type(std::shared_ptr<Container> const& entries) noexcept
     : _values {entries}
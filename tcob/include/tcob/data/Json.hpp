@@ -0,0 +1,32 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+namespace tcob::data {
+////////////////////////////////////////////////////////////
+
+// String views are only valid during the callback; returning false aborts parsing.
+class TCOB_API json_sax_handler {
+public:
+    virtual ~json_sax_handler() = default;
+
+    virtual auto on_null() -> bool                         = 0;
+    virtual auto on_bool(bool value) -> bool               = 0;
+    virtual auto on_int(i64 value) -> bool                 = 0;
+    virtual auto on_float(f64 value) -> bool               = 0;
+    virtual auto on_string(utf8_string_view value) -> bool = 0;
+
+    virtual auto on_key(utf8_string_view key) -> bool = 0;
+    virtual auto on_object_begin() -> bool            = 0;
+    virtual auto on_object_end() -> bool              = 0;
+    virtual auto on_array_begin() -> bool             = 0;
+    virtual auto on_array_end() -> bool               = 0;
+};
+
+TCOB_API auto parse_json(utf8_string_view json, json_sax_handler& handler) -> bool;
+
+}
@@ -6,7 +6,12 @@
 #pragma once
 #include "tcob/tcob_config.hpp"
 
+#include <list>
+#include <memory>
 #include <type_traits>
+#include <unordered_map>
+
+#include "tcob/core/Interfaces.hpp"
 
 #if defined(TCOB_ENABLE_ADDON_DATA_SQLITE)
 
@@ -94,6 +99,8 @@ public:
     auto bind(i32 idx, void const* value, i64 size) const -> bool;
     auto bind_null(i32 idx) -> bool;
 
+    auto reset() const -> bool;
+    auto clear_bindings() const -> bool;
     void finalize();
 
     auto get_column_name(i32 col) const -> utf8_string;
@@ -105,6 +112,30 @@ private:
 
 ////////////////////////////////////////////////////////////
 
+class TCOB_API statement_cache final : public non_copyable {
+public:
+    static constexpr usize DefaultCapacity {32};
+
+    explicit statement_cache(usize capacity = DefaultCapacity);
+    ~statement_cache();
+
+    auto size() const -> usize;
+
+    auto acquire(utf8_string const& sql) -> statement_view;
+    void release(utf8_string const& sql, statement_view stmt);
+
+    void close();
+
+private:
+    using entry = std::pair<utf8_string, statement_view>;
+
+    std::list<entry>                                            _entries; //!< most recently used first
+    std::unordered_map<utf8_string, std::list<entry>::iterator> _lookup;
+    usize                                                       _capacity;
+};
+
+////////////////////////////////////////////////////////////
+
 class TCOB_API database_view final {
 public:
     explicit database_view(sqlite3* db);
@@ -119,6 +150,10 @@ public:
 
     auto prepare(utf8_string_view sql) const -> statement_view;
 
+    auto with_statement_cache(usize capacity = statement_cache::DefaultCapacity) const -> database_view;
+    auto acquire_statement(utf8_string const& sql) const -> statement_view;
+    void release_statement(utf8_string const& sql, statement_view stmt) const;
+
     auto exec(utf8_string const& sql) const -> bool;
 
     void commit_hook(i32 (*callback)(void*), void* userdata) const;
@@ -128,7 +163,8 @@ public:
     auto config(i32 key, i32 value) const -> bool;
 
 private:
-    sqlite3* _db {nullptr};
+    sqlite3*                         _db {nullptr};
+    std::shared_ptr<statement_cache> _cache;
 };
 
 }
@@ -8,8 +8,12 @@
 
 #if defined(TCOB_ENABLE_ADDON_DATA_SQLITE)
 
+    #include <cstddef>
     #include <functional>
+    #include <iterator>
     #include <optional>
+    #include <tuple>
+    #include <type_traits>
     #include <utility>
     #include <vector>
 
@@ -29,6 +33,7 @@ public:
 
     auto prepare(utf8_string const& sql) -> bool;
     auto step() const -> step_status;
+    auto reset() const -> bool;
 
     auto column_count() const -> i32;
     template <typename T>
@@ -46,12 +51,57 @@ protected:
 private:
     database_view  _db;
     statement_view _stmt;
+    utf8_string    _sql;
 };
 
 using bind_func = std::function<void(i32&, statement&)>;
 
 ////////////////////////////////////////////////////////////
 
+template <typename... Values>
+class row_cursor final : public non_copyable {
+public:
+    using value_type = std::conditional_t<sizeof...(Values) == 1, std::tuple_element_t<0, std::tuple<Values...>>, std::tuple<Values...>>;
+
+    class iterator final {
+    public:
+        using value_type      = row_cursor::value_type;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(row_cursor* cursor);
+
+        auto operator*() const -> value_type const&;
+        auto operator->() const -> value_type const*;
+
+        auto operator++() -> iterator&;
+        void operator++(int);
+
+        auto operator==(std::default_sentinel_t) const -> bool;
+
+    private:
+        row_cursor* _cursor {nullptr};
+    };
+
+    explicit row_cursor(statement* stmt);
+    row_cursor(row_cursor&& other) noexcept;
+    auto operator=(row_cursor&& other) noexcept -> row_cursor&;
+    ~row_cursor();
+
+    auto begin() -> iterator;
+    auto end() const -> std::default_sentinel_t;
+
+private:
+    void advance();
+
+    statement* _stmt {nullptr};
+    value_type _current {};
+    bool       _started {false};
+    bool       _done {true};
+};
+
+////////////////////////////////////////////////////////////
+
 template <typename... Values>
 class select_statement : public statement {
 public:
@@ -62,6 +112,8 @@ public:
     template <typename T>
     auto exec [[nodiscard]] (auto&&... params) -> std::vector<T>;
 
+    auto rows [[nodiscard]] (auto&&... params) -> row_cursor<Values...>;
+
     template <typename T>
     auto where(T const& cond) -> select_statement&;
     template <typename T>
@@ -107,6 +159,7 @@ private:
 
     std::vector<std::pair<utf8_string, utf8_string>> _setOps;
     values                                           _values;
+    utf8_string                                      _query;
     bind_func                                        _whereBind;
     bind_func                                        _havingBind;
     bool                                             _distinct;
@@ -148,6 +201,8 @@ public:
 private:
     auto query_string(usize columnCount, usize rowCount) const -> utf8_string;
 
+    auto exec_batch(auto&&... values) -> bool;
+
     utf8_string _sql;
     usize       _columnCount;
 };
@@ -11,13 +11,17 @@
     #include <array>
     #include <cassert>
     #include <format>
+    #include <iterator>
     #include <optional>
     #include <tuple>
     #include <type_traits>
+    #include <utility>
     #include <vector>
 
+    #include "tcob/core/Concepts.hpp"
     #include "tcob/core/StringUtils.hpp"
     #include "tcob/data/Sqlite.hpp"
+    #include "tcob/data/SqliteSavepoint.hpp"
 
 namespace tcob::db {
 
@@ -37,10 +41,13 @@ namespace detail {
         static constexpr usize Size {sizeof...(Ts)};
     };
 
+    template <typename T>
+    concept RowRange = (Container<T> || Set<T>) && !std::is_convertible_v<T const&, utf8_string_view>;
+
     auto count(auto&& value, auto&&... values) -> usize
     {
         usize retValue {};
-        if constexpr (HasSize<std::remove_cvref_t<decltype(value)>>) {
+        if constexpr (RowRange<std::remove_cvref_t<decltype(value)>>) {
             retValue = value.size();
         } else {
             retValue = 1;
@@ -72,6 +79,102 @@ inline auto statement::bind_parameter(i32& idx, T&& value) const -> bool
 
 ////////////////////////////////////////////////////////////
 
+template <typename... Values>
+inline row_cursor<Values...>::iterator::iterator(row_cursor* cursor)
+    : _cursor {cursor}
+{
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::iterator::operator*() const -> value_type const&
+{
+    return _cursor->_current;
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::iterator::operator->() const -> value_type const*
+{
+    return &_cursor->_current;
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::iterator::operator++() -> iterator&
+{
+    _cursor->advance();
+    return *this;
+}
+
+template <typename... Values>
+inline void row_cursor<Values...>::iterator::operator++(int)
+{
+    _cursor->advance();
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::iterator::operator==(std::default_sentinel_t) const -> bool
+{
+    return !_cursor || _cursor->_done;
+}
+
+template <typename... Values>
+inline row_cursor<Values...>::row_cursor(statement* stmt)
+    : _stmt {stmt}
+{
+}
+
+template <typename... Values>
+inline row_cursor<Values...>::row_cursor(row_cursor&& other) noexcept
+    : _stmt {std::exchange(other._stmt, nullptr)}
+    , _current {std::move(other._current)}
+    , _started {other._started}
+    , _done {other._done}
+{
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::operator=(row_cursor&& other) noexcept -> row_cursor&
+{
+    std::swap(_stmt, other._stmt);
+    std::swap(_current, other._current);
+    std::swap(_started, other._started);
+    std::swap(_done, other._done);
+    return *this;
+}
+
+template <typename... Values>
+inline row_cursor<Values...>::~row_cursor()
+{
+    // release the read lock if iteration stopped early
+    if (_stmt) { _stmt->reset(); }
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::begin() -> iterator
+{
+    if (!_started) {
+        _started = true;
+        advance();
+    }
+    return iterator {this};
+}
+
+template <typename... Values>
+inline auto row_cursor<Values...>::end() const -> std::default_sentinel_t
+{
+    return std::default_sentinel;
+}
+
+template <typename... Values>
+inline void row_cursor<Values...>::advance()
+{
+    _done = !_stmt || _stmt->step() != step_status::Row;
+    if (!_done) {
+        _current = _stmt->get_column_value<value_type>(0);
+    }
+}
+
+////////////////////////////////////////////////////////////
+
 template <typename... Values>
 inline select_statement<Values...>::select_statement(database_view db, bool addDistinct, utf8_string const& schemaName, utf8_string const& table, utf8_string const& columns)
     : statement {db}
@@ -93,6 +196,7 @@ inline auto select_statement<Values...>::where(T const& cond) -> select_statemen
     _values.Where = std::format(" WHERE {}", cond.str());
     _whereBind    = cond.bind();
 
+    _query.clear();
     return *this;
 }
 
@@ -103,6 +207,7 @@ inline auto select_statement<Values...>::having(T const& cond) -> select_stateme
     _values.Having = std::format(" HAVING {}", cond.str());
     _havingBind    = cond.bind();
 
+    _query.clear();
     return *this;
 }
 
@@ -111,6 +216,7 @@ inline auto select_statement<Values...>::order_by(auto&&... orderings) -> select
 {
     std::array<utf8_string, sizeof...(orderings)> const colStrings {{orderings.str()...}};
     _values.OrderBy = std::format(" ORDER BY {}", helper::join(colStrings, ", "));
+    _query.clear();
     return *this;
 }
 
@@ -122,6 +228,7 @@ inline auto select_statement<Values...>::limit(i32 value, std::optional<i32> off
         _values.Offset = std::format(" OFFSET {}", *offset);
     }
 
+    _query.clear();
     return *this;
 }
 
@@ -136,6 +243,7 @@ inline auto select_statement<Values...>::group_by(auto&&... columns) -> select_s
         }
     }()...}};
     _values.GroupBy = std::format(" GROUP BY {}", helper::join(colStrings, ", "));
+    _query.clear();
     return *this;
 }
 
@@ -150,6 +258,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::left_join(auto const& table, auto const& on) -> select_statement<Values...>&
 {
     _values.Join = std::format(" LEFT JOIN {} ON ({})", table.qualified_name(), on_str(table, on));
+    _query.clear();
     return *this;
 }
 
@@ -157,6 +266,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::right_join(auto const& table, auto const& on) -> select_statement<Values...>&
 {
     _values.Join = std::format(" RIGHT JOIN {} ON ({})", table.qualified_name(), on_str(table, on));
+    _query.clear();
     return *this;
 }
 
@@ -164,6 +274,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::full_join(auto const& table, auto const& on) -> select_statement<Values...>&
 {
     _values.Join = std::format(" FULL JOIN {} ON ({})", table.qualified_name(), on_str(table, on));
+    _query.clear();
     return *this;
 }
 
@@ -171,6 +282,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::inner_join(auto const& table, auto const& on) -> select_statement<Values...>&
 {
     _values.Join = std::format(" INNER JOIN {} ON ({})", table.qualified_name(), on_str(table, on));
+    _query.clear();
     return *this;
 }
 
@@ -178,6 +290,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::cross_join(auto const& table) -> select_statement<Values...>&
 {
     _values.Join = std::format(" CROSS JOIN {}", table.qualified_name());
+    _query.clear();
     return *this;
 }
 
@@ -185,6 +298,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::union_with(select_statement const& other) -> select_statement&
 {
     _setOps.emplace_back("UNION", other.query_string());
+    _query.clear();
     return *this;
 }
 
@@ -192,6 +306,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::union_all_with(select_statement const& other) -> select_statement&
 {
     _setOps.emplace_back("UNION ALL", other.query_string());
+    _query.clear();
     return *this;
 }
 
@@ -199,6 +314,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::intersect(select_statement const& other) -> select_statement&
 {
     _setOps.emplace_back("INTERSECT", other.query_string());
+    _query.clear();
     return *this;
 }
 
@@ -206,6 +322,7 @@ template <typename... Values>
 inline auto select_statement<Values...>::except(select_statement const& other) -> select_statement&
 {
     _setOps.emplace_back("EXCEPT", other.query_string());
+    _query.clear();
     return *this;
 }
 
@@ -230,7 +347,8 @@ template <typename... Values>
 inline auto select_statement<Values...>::prepare_and_bind(auto&&... params) -> bool
 {
     // prepare
-    if (!prepare(query_string() + ";")) { return false; };
+    if (_query.empty()) { _query = query_string() + ";"; }
+    if (!prepare(_query)) { return false; };
 
     // bind parameters
     i32 idx {1};
@@ -288,6 +406,15 @@ inline auto select_statement<Values...>::exec [[nodiscard]] (auto&&... params) -
     return retValue;
 }
 
+template <typename... Values>
+inline auto select_statement<Values...>::rows [[nodiscard]] (auto&&... params) -> row_cursor<Values...>
+{
+    if (!prepare_and_bind(params...)) { return row_cursor<Values...> {nullptr}; }
+    if (sizeof...(Values) != column_count()) { return row_cursor<Values...> {nullptr}; }
+
+    return row_cursor<Values...> {this};
+}
+
 ////////////////////////////////////////////////////////////
 
 inline auto update_statement::operator()(auto&&... values) -> bool
@@ -317,24 +444,24 @@ inline auto update_statement::where(T const& cond) -> update_statement&
 
 inline auto insert_statement::operator()(auto&& value, auto&&... values) -> bool
 {
-    // prepare
     usize constexpr columnsPerValue {detail::value_size<std::remove_cvref_t<decltype(value)>>::Size};
     static_assert(((detail::value_size<std::remove_cvref_t<decltype(values)>>::Size == columnsPerValue) && ...), "All inserted values must have the same number of columns");
 
     usize const valueCount {detail::count(value, values...)};
-    bool const  singleValues {columnsPerValue == 1 && (valueCount % _columnCount) == 0};
-    if (singleValues) {
-        if (!prepare(query_string(_columnCount, valueCount / _columnCount))) {
-            return false;
-        }
+    usize       rowCount {0};
+    if (columnsPerValue == 1 && (valueCount % _columnCount) == 0) {
+        rowCount = valueCount / _columnCount;
     } else if (_columnCount == columnsPerValue) {
-        if (!prepare(query_string(columnsPerValue, valueCount))) {
-            return false;
-        }
+        rowCount = valueCount;
     } else {
         return false;
     }
 
+    if (rowCount != 1) { return exec_batch(value, values...); }
+
+    // prepare
+    if (!prepare(query_string(_columnCount, 1))) { return false; }
+
     // bind parameters
     i32 idx {1};
     bind_parameter(idx, value);
@@ -344,6 +471,42 @@ inline auto insert_statement::operator()(auto&& value, auto&&... values) -> bool
     return step() == step_status::Done;
 }
 
+inline auto insert_statement::exec_batch(auto&&... values) -> bool
+{
+    // prepare a single row once and execute it per row inside a savepoint
+    if (!prepare(query_string(_columnCount, 1))) { return false; }
+
+    savepoint sp {get_db(), "tcob_insert_batch"};
+
+    i32  idx {1};
+    bool ok {true};
+
+    auto const bindValue {[&](auto const& item) {
+        if (!ok) { return; }
+
+        bind_parameter(idx, item);
+        if (idx > static_cast<i32>(_columnCount)) {
+            ok  = step() == step_status::Done && reset();
+            idx = 1;
+        }
+    }};
+
+    auto const bindRange {[&](auto const& value) {
+        if constexpr (detail::RowRange<std::remove_cvref_t<decltype(value)>>) {
+            for (auto const& item : value) { bindValue(item); }
+        } else {
+            bindValue(value);
+        }
+    }};
+
+    (bindRange(values), ...);
+
+    if (!ok) { return false; } // savepoint rolls back
+
+    sp.release();
+    return true;
+}
+
 ////////////////////////////////////////////////////////////
 
 inline auto delete_statement::operator()(auto&&... values) -> bool
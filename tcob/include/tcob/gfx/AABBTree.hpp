@@ -0,0 +1,81 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+#include <limits>
+#include <vector>
+
+#include "tcob/core/Rect.hpp"
+#include "tcob/gfx/Ray.hpp"
+
+namespace tcob::gfx {
+////////////////////////////////////////////////////////////
+
+// Dynamic bounding volume hierarchy with one value per leaf.
+// Handles stay valid until the value is removed, even across rebuilds.
+template <typename T>
+class aabb_tree {
+public:
+    using handle = u32;
+
+    auto add(rect_f const& bounds, T const& value) -> handle; //!< rotates the ancestors, so the height stays logarithmic in any insertion order
+
+    void update(handle h, rect_f const& bounds); //!< refits the ancestors, the structure stays the same
+
+    void remove(handle h);
+
+    void clear();
+
+    void rebuild(); //!< rebuilds the hierarchy using the surface area heuristic
+
+    template <typename Func>
+    void query(rect_f const& rect, Func&& func) const; //!< calls func(T const&) for every leaf intersecting rect
+
+    template <typename Func>
+    void raycast(ray const& ray, Func&& func) const; //!< calls f64 func(T const&, f64 maxDistance) nearest first, the returned distance clips the ray
+
+    auto get(handle h) const -> T const&;
+    auto bounds(handle h) const -> rect_f const&;
+
+    auto size() const -> usize;
+    auto height() const -> i32; //!< zero for a single leaf
+
+private:
+    static constexpr u32 NONE {std::numeric_limits<u32>::max()};
+
+    struct node {
+        rect_f Bounds {};
+        u32    Parent {NONE}; //!< also links the free list
+        u32    Left {NONE};
+        u32    Right {NONE};
+        i32    Height {-1}; //!< -1 for free nodes, 0 for leaves
+        T      Value {};
+    };
+
+    auto allocate_node() -> u32;
+    void free_node(u32 idx);
+
+    void insert_leaf(u32 leaf);
+    void remove_leaf(u32 leaf);
+    void refit(u32 idx);
+    void rebalance(u32 idx);
+    auto rotate(u32 idx) -> u32;
+
+    auto build(std::vector<u32>& leaves, usize first, usize last) -> u32;
+
+    static auto Union(rect_f const& a, rect_f const& b) -> rect_f;
+    static auto Perimeter(rect_f const& rect) -> f32;
+
+    std::vector<node> _nodes;
+    u32               _root {NONE};
+    u32               _freeNode {NONE};
+    usize             _size {0};
+};
+
+}
+
+#include "AABBTree.inl"
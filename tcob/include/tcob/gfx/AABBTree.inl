@@ -0,0 +1,453 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "AABBTree.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <limits>
+#include <vector>
+
+#include "tcob/core/Point.hpp"
+#include "tcob/core/Rect.hpp"
+#include "tcob/gfx/Ray.hpp"
+
+namespace tcob::gfx {
+////////////////////////////////////////////////////////////
+
+template <typename T>
+inline auto aabb_tree<T>::add(rect_f const& bounds, T const& value) -> handle
+{
+    u32 const leaf {allocate_node()};
+    auto&     n {_nodes[leaf]};
+    n.Bounds = bounds;
+    n.Value  = value;
+    n.Height = 0;
+
+    insert_leaf(leaf);
+    ++_size;
+    return leaf;
+}
+
+template <typename T>
+inline void aabb_tree<T>::update(handle h, rect_f const& bounds)
+{
+    assert(h < _nodes.size() && _nodes[h].Height == 0);
+
+    if (_nodes[h].Bounds == bounds) { return; }
+    _nodes[h].Bounds = bounds;
+    refit(_nodes[h].Parent);
+}
+
+template <typename T>
+inline void aabb_tree<T>::remove(handle h)
+{
+    assert(h < _nodes.size() && _nodes[h].Height == 0);
+
+    remove_leaf(h);
+    free_node(h);
+    --_size;
+}
+
+template <typename T>
+inline void aabb_tree<T>::clear()
+{
+    _nodes.clear();
+    _root     = NONE;
+    _freeNode = NONE;
+    _size     = 0;
+}
+
+template <typename T>
+inline void aabb_tree<T>::rebuild()
+{
+    if (_root == NONE) { return; }
+
+    // internal nodes are thrown away, leaves keep their index
+    std::vector<u32> leaves;
+    leaves.reserve(_size);
+    for (u32 i {0}; i < _nodes.size(); ++i) {
+        if (_nodes[i].Height == 0) {
+            leaves.push_back(i);
+        } else if (_nodes[i].Height > 0) {
+            free_node(i);
+        }
+    }
+
+    _root                = build(leaves, 0, leaves.size());
+    _nodes[_root].Parent = NONE;
+}
+
+template <typename T>
+template <typename Func>
+inline void aabb_tree<T>::query(rect_f const& rect, Func&& func) const
+{
+    // stackless traversal, the parent links tell where we came from
+    u32 idx {_root};
+    u32 prev {NONE};
+    while (idx != NONE) {
+        node const& n {_nodes[idx]};
+        u32         next {n.Parent};
+        if (prev == n.Parent) {
+            if (n.Bounds.intersects(rect, true)) {
+                if (n.Height == 0) {
+                    func(n.Value);
+                } else {
+                    next = n.Left;
+                }
+            }
+        } else if (prev == n.Left) {
+            next = n.Right;
+        }
+
+        prev = idx;
+        idx  = next;
+    }
+}
+
+template <typename T>
+template <typename Func>
+inline void aabb_tree<T>::raycast(ray const& ray, Func&& func) const
+{
+    if (_root == NONE) { return; }
+
+    f64 maxDistance {std::numeric_limits<f64>::max()};
+    if (!ray.intersect_aabb(_nodes[_root].Bounds, maxDistance)) { return; }
+
+    auto const entry {[&](u32 child) {
+        auto const distance {ray.intersect_aabb(_nodes[child].Bounds, maxDistance)};
+        return distance ? *distance : std::numeric_limits<f64>::infinity();
+    }};
+
+    // children are only entered if the ray reaches them before maxDistance;
+    // a shrinking maxDistance never swaps the order of the two children
+    u32 idx {_root};
+    u32 prev {NONE};
+    while (idx != NONE) {
+        node const& n {_nodes[idx]};
+        u32         next {n.Parent};
+        if (n.Height == 0) {
+            maxDistance = func(n.Value, maxDistance);
+        } else {
+            f64 const left {entry(n.Left)};
+            f64 const right {entry(n.Right)};
+            u32 const first {left <= right ? n.Left : n.Right};
+            u32 const second {left <= right ? n.Right : n.Left};
+
+            if (prev == n.Parent) {
+                if (std::min(left, right) <= maxDistance) { next = first; }
+            } else if (prev == first) {
+                if (std::max(left, right) <= maxDistance) { next = second; }
+            }
+        }
+
+        prev = idx;
+        idx  = next;
+    }
+}
+
+template <typename T>
+inline auto aabb_tree<T>::get(handle h) const -> T const&
+{
+    assert(h < _nodes.size() && _nodes[h].Height == 0);
+    return _nodes[h].Value;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::bounds(handle h) const -> rect_f const&
+{
+    assert(h < _nodes.size() && _nodes[h].Height == 0);
+    return _nodes[h].Bounds;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::size() const -> usize
+{
+    return _size;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::height() const -> i32
+{
+    return _root == NONE ? 0 : _nodes[_root].Height;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::allocate_node() -> u32
+{
+    if (_freeNode == NONE) {
+        _nodes.emplace_back();
+        return static_cast<u32>(_nodes.size() - 1);
+    }
+
+    u32 const idx {_freeNode};
+    _freeNode   = _nodes[idx].Parent;
+    _nodes[idx] = node {};
+    return idx;
+}
+
+template <typename T>
+inline void aabb_tree<T>::free_node(u32 idx)
+{
+    auto& n {_nodes[idx]};
+    n.Height  = -1;
+    n.Value   = T {};
+    n.Parent  = _freeNode;
+    _freeNode = idx;
+}
+
+template <typename T>
+inline void aabb_tree<T>::insert_leaf(u32 leaf)
+{
+    if (_root == NONE) {
+        _root               = leaf;
+        _nodes[leaf].Parent = NONE;
+        return;
+    }
+
+    // walk down towards the cheapest sibling
+    rect_f const bounds {_nodes[leaf].Bounds};
+    u32          sibling {_root};
+    while (_nodes[sibling].Height > 0) {
+        auto const& n {_nodes[sibling]};
+
+        f32 const combined {Perimeter(Union(n.Bounds, bounds))};
+        f32 const cost {2.0f * combined};
+        f32 const inheritance {2.0f * (combined - Perimeter(n.Bounds))};
+
+        auto const childCost {[&](u32 child) {
+            auto const& c {_nodes[child]};
+            f32 const   grown {Perimeter(Union(c.Bounds, bounds))};
+            return (c.Height == 0 ? grown : grown - Perimeter(c.Bounds)) + inheritance;
+        }};
+        f32 const costLeft {childCost(n.Left)};
+        f32 const costRight {childCost(n.Right)};
+
+        if (cost < costLeft && cost < costRight) { break; }
+        sibling = costLeft < costRight ? n.Left : n.Right;
+    }
+
+    u32 const oldParent {_nodes[sibling].Parent};
+    u32 const newParent {allocate_node()};
+    auto&     p {_nodes[newParent]};
+    p.Parent = oldParent;
+    p.Left   = sibling;
+    p.Right  = leaf;
+
+    _nodes[sibling].Parent = newParent;
+    _nodes[leaf].Parent    = newParent;
+
+    if (oldParent == NONE) {
+        _root = newParent;
+    } else {
+        auto& op {_nodes[oldParent]};
+        (op.Left == sibling ? op.Left : op.Right) = newParent;
+    }
+    rebalance(newParent);
+}
+
+template <typename T>
+inline void aabb_tree<T>::remove_leaf(u32 leaf)
+{
+    if (leaf == _root) {
+        _root = NONE;
+        return;
+    }
+
+    u32 const parent {_nodes[leaf].Parent};
+    u32 const grandParent {_nodes[parent].Parent};
+    u32 const sibling {_nodes[parent].Left == leaf ? _nodes[parent].Right : _nodes[parent].Left};
+
+    _nodes[sibling].Parent = grandParent;
+    if (grandParent == NONE) {
+        _root = sibling;
+    } else {
+        auto& gp {_nodes[grandParent]};
+        (gp.Left == parent ? gp.Left : gp.Right) = sibling;
+        rebalance(grandParent);
+    }
+
+    free_node(parent);
+}
+
+template <typename T>
+inline void aabb_tree<T>::refit(u32 idx)
+{
+    while (idx != NONE) {
+        auto&        n {_nodes[idx]};
+        rect_f const bounds {Union(_nodes[n.Left].Bounds, _nodes[n.Right].Bounds)};
+        i32 const    height {1 + std::max(_nodes[n.Left].Height, _nodes[n.Right].Height)};
+        if (bounds == n.Bounds && height == n.Height) { return; } // ancestors are unchanged as well
+
+        n.Bounds = bounds;
+        n.Height = height;
+        idx      = n.Parent;
+    }
+}
+
+template <typename T>
+inline void aabb_tree<T>::rebalance(u32 idx)
+{
+    // unlike refit this walks up to the root, rotations can change the height above an unchanged node
+    while (idx != NONE) {
+        idx = rotate(idx);
+
+        auto& n {_nodes[idx]};
+        n.Bounds = Union(_nodes[n.Left].Bounds, _nodes[n.Right].Bounds);
+        n.Height = 1 + std::max(_nodes[n.Left].Height, _nodes[n.Right].Height);
+        idx      = n.Parent;
+    }
+}
+
+template <typename T>
+inline auto aabb_tree<T>::rotate(u32 idx) -> u32
+{
+    // lifts the taller child into the place of idx, returns the node now in that place
+    auto& a {_nodes[idx]};
+    if (a.Height < 2) { return idx; }
+
+    i32 const balance {_nodes[a.Right].Height - _nodes[a.Left].Height};
+    if (balance >= -1 && balance <= 1) { return idx; }
+
+    bool const rightUp {balance > 1};
+    u32 const  up {rightUp ? a.Right : a.Left};
+    u32 const  stay {rightUp ? a.Left : a.Right};
+    auto&      b {_nodes[up]};
+
+    // up takes the place of idx, idx becomes its first child
+    b.Parent = a.Parent;
+    a.Parent = up;
+    if (b.Parent == NONE) {
+        _root = up;
+    } else {
+        auto& p {_nodes[b.Parent]};
+        (p.Left == idx ? p.Left : p.Right) = up;
+    }
+
+    // the taller grandchild stays with up, the shorter one moves down to idx
+    u32 const taller {_nodes[b.Left].Height > _nodes[b.Right].Height ? b.Left : b.Right};
+    u32 const shorter {taller == b.Left ? b.Right : b.Left};
+    b.Left                       = idx;
+    b.Right                      = taller;
+    (rightUp ? a.Right : a.Left) = shorter;
+    _nodes[shorter].Parent       = idx;
+
+    a.Bounds = Union(_nodes[stay].Bounds, _nodes[shorter].Bounds);
+    a.Height = 1 + std::max(_nodes[stay].Height, _nodes[shorter].Height);
+    b.Bounds = Union(a.Bounds, _nodes[taller].Bounds);
+    b.Height = 1 + std::max(a.Height, _nodes[taller].Height);
+    return up;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::build(std::vector<u32>& leaves, usize first, usize last) -> u32
+{
+    if (last - first == 1) { return leaves[first]; }
+
+    auto const center {[this](u32 leaf) { return _nodes[leaf].Bounds.center(); }};
+
+    point_f minCenter {center(leaves[first])};
+    point_f maxCenter {minCenter};
+    for (usize i {first + 1}; i < last; ++i) {
+        point_f const c {center(leaves[i])};
+        minCenter = {std::min(minCenter.X, c.X), std::min(minCenter.Y, c.Y)};
+        maxCenter = {std::max(maxCenter.X, c.X), std::max(maxCenter.Y, c.Y)};
+    }
+
+    bool const splitX {maxCenter.X - minCenter.X >= maxCenter.Y - minCenter.Y};
+    f32 const  axisMin {splitX ? minCenter.X : minCenter.Y};
+    f32 const  extent {splitX ? maxCenter.X - minCenter.X : maxCenter.Y - minCenter.Y};
+    usize      mid {first + ((last - first) / 2)};
+    auto const axisValue {[&](u32 leaf) { return splitX ? center(leaf).X : center(leaf).Y; }};
+
+    if (extent > 0.0f) {
+        // binned surface area heuristic along the longer axis
+        static constexpr usize BinCount {12};
+        struct bin {
+            rect_f Bounds {};
+            usize  Count {0};
+        };
+        std::array<bin, BinCount> bins {};
+
+        auto const binOf {[&](u32 leaf) {
+            return std::min(BinCount - 1, static_cast<usize>((axisValue(leaf) - axisMin) / extent * BinCount));
+        }};
+        for (usize i {first}; i < last; ++i) {
+            auto& b {bins[binOf(leaves[i])]};
+            b.Bounds = b.Count == 0 ? _nodes[leaves[i]].Bounds : Union(b.Bounds, _nodes[leaves[i]].Bounds);
+            ++b.Count;
+        }
+
+        std::array<f32, BinCount> rightCost {};
+        bin                       acc {};
+        for (usize i {BinCount - 1}; i > 0; --i) {
+            if (bins[i].Count > 0) {
+                acc.Bounds = acc.Count == 0 ? bins[i].Bounds : Union(acc.Bounds, bins[i].Bounds);
+                acc.Count += bins[i].Count;
+            }
+            rightCost[i] = acc.Count == 0 ? 0.0f : static_cast<f32>(acc.Count) * Perimeter(acc.Bounds);
+        }
+
+        f32   bestCost {std::numeric_limits<f32>::max()};
+        usize bestSplit {BinCount};
+        acc = {};
+        for (usize i {0}; i < BinCount - 1; ++i) {
+            if (bins[i].Count > 0) {
+                acc.Bounds = acc.Count == 0 ? bins[i].Bounds : Union(acc.Bounds, bins[i].Bounds);
+                acc.Count += bins[i].Count;
+            }
+            if (acc.Count == 0 || acc.Count == last - first) { continue; }
+
+            f32 const cost {(static_cast<f32>(acc.Count) * Perimeter(acc.Bounds)) + rightCost[i + 1]};
+            if (cost < bestCost) {
+                bestCost  = cost;
+                bestSplit = i;
+            }
+        }
+
+        if (bestSplit != BinCount) {
+            auto const it {std::partition(leaves.begin() + static_cast<isize>(first), leaves.begin() + static_cast<isize>(last),
+                                          [&](u32 leaf) { return binOf(leaf) <= bestSplit; })};
+            mid = static_cast<usize>(it - leaves.begin());
+        }
+    }
+
+    if (mid == first || mid == last || extent <= 0.0f) {
+        // all centers fall into one bin, fall back to a median split
+        mid = first + ((last - first) / 2);
+        std::nth_element(leaves.begin() + static_cast<isize>(first), leaves.begin() + static_cast<isize>(mid), leaves.begin() + static_cast<isize>(last),
+                         [&](u32 a, u32 b) { return axisValue(a) < axisValue(b); });
+    }
+
+    u32 const idx {allocate_node()};
+    u32 const left {build(leaves, first, mid)};
+    u32 const right {build(leaves, mid, last)};
+
+    auto& n {_nodes[idx]};
+    n.Left               = left;
+    n.Right              = right;
+    n.Bounds             = Union(_nodes[left].Bounds, _nodes[right].Bounds);
+    n.Height             = 1 + std::max(_nodes[left].Height, _nodes[right].Height);
+    _nodes[left].Parent  = idx;
+    _nodes[right].Parent = idx;
+    return idx;
+}
+
+template <typename T>
+inline auto aabb_tree<T>::Union(rect_f const& a, rect_f const& b) -> rect_f
+{
+    return rect_f::FromLTRB(std::min(a.left(), b.left()), std::min(a.top(), b.top()),
+                            std::max(a.right(), b.right()), std::max(a.bottom(), b.bottom()));
+}
+
+template <typename T>
+inline auto aabb_tree<T>::Perimeter(rect_f const& rect) -> f32
+{
+    return 2.0f * (rect.width() + rect.height());
+}
+
+}
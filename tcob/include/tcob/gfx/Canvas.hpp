@@ -209,7 +209,9 @@ public:
 
     // Image
     void draw_image(texture* image, string const& region, rect_f const& rect);
+    void draw_image(texture* image, texture_region_handle const& region, rect_f const& rect);
     void draw_nine_patch(texture* image, string const& region, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV);
+    void draw_nine_patch(texture* image, texture_region_handle const& region, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV);
 
     // Transforms
     void translate(point_f c);
@@ -245,6 +247,9 @@ public:
 private:
     void set_device_pixel_ratio(f32 ratio);
 
+    void draw_image_region(texture* image, texture_region const& texRegion, rect_f const& rect);
+    void draw_nine_patch_region(texture* image, texture_region const& texRegion, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV);
+
     void set_paint_color(paint& p, color c);
     auto get_font_scale() -> f32;
     void render_text(font* font, std::span<vertex const> verts);
@@ -8,6 +8,7 @@
 
 #include <compare>
 #include <functional>
+#include <limits>
 #include <set>
 #include <tuple>
 
@@ -155,6 +156,36 @@ public:
 
 ////////////////////////////////////////////////////////////
 
+// Interned region name, resolve it once (e.g. at load time) and use it with any texture.
+// Names are reference counted; once the last handle to a name is gone, its id gets reused.
+class TCOB_API texture_region_handle final {
+    friend class texture_region_map;
+
+public:
+    texture_region_handle() = default;
+    explicit texture_region_handle(string const& name); //!< interns the name, thread-safe
+    texture_region_handle(texture_region_handle const& other);
+    texture_region_handle(texture_region_handle&& other) noexcept;
+    ~texture_region_handle();
+
+    auto operator=(texture_region_handle const& other) -> texture_region_handle&;
+    auto operator=(texture_region_handle&& other) noexcept -> texture_region_handle&;
+
+    auto is_valid() const -> bool;
+    auto name() const -> string;
+
+    auto operator==(texture_region_handle const& other) const -> bool = default;
+
+    static auto Find(string const& name) -> texture_region_handle; //!< doesn't intern, invalid if the name is unknown
+
+private:
+    void release();
+
+    u32 _id {std::numeric_limits<u32>::max()};
+};
+
+////////////////////////////////////////////////////////////
+
 enum class horizontal_alignment : u8 {
     Left,
     Right,
@@ -254,6 +285,7 @@ namespace gfx {
     class canvas;
     class font;
     class parallax_background;
+    class render_queue;
     class render_system;
     class render_target;
     struct render_properties;
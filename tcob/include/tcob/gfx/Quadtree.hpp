@@ -11,6 +11,7 @@
 #include "tcob/tcob_config.hpp"
 
 #include <array>
+#include <limits>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -27,6 +28,12 @@ concept QuadtreeValue =
         { t == t } -> std::same_as<bool>;
     };
 
+template <typename T>
+concept LooseQuadtreeValue =
+    requires(T const& t) {
+        { t.get_rect() } -> std::convertible_to<rect_f>;
+    };
+
 ////////////////////////////////////////////////////////////
 
 namespace detail {
@@ -94,6 +101,76 @@ private:
     std::unique_ptr<node> _root;
 };
 
+////////////////////////////////////////////////////////////
+
+// Values are placed by size and center, and every node accepts values reaching up to half its size beyond its bounds.
+// Moving values rarely change their node, and values outside of the tree bounds stay in the root.
+template <LooseQuadtreeValue T, usize SplitThreshold = 16, usize MaxDepth = 8>
+class loose_quadtree {
+public:
+    using handle = u32;
+
+    explicit loose_quadtree(rect_f const& rect);
+
+    auto add(T const& value) -> handle;
+
+    void update(handle h, T const& value); //!< only relinks the value if it no longer fits its node
+
+    void remove(handle h);
+
+    void clear();
+
+    void rebuild(); //!< rebuilds all nodes in one pass, handles stay valid
+
+    template <typename Func>
+    void query(rect_f const& rect, Func&& func) const; //!< calls func(T const&) for every value intersecting rect
+
+    void query(rect_f const& rect, std::vector<T>& values) const; //!< appends to values
+
+    auto get(handle h) const -> T const&;
+    auto size() const -> usize;
+
+    auto bounds() const -> rect_f const&;
+
+private:
+    static constexpr u32 NONE {std::numeric_limits<u32>::max()};
+
+    struct node {
+        rect_f Bounds {};
+        u32    Children {NONE}; //!< index of the first of four consecutive children
+        u32    Parent {NONE};
+        u32    First {NONE}; //!< head of the intrusive value list
+        u32    Count {0};
+        usize  Depth {0};
+    };
+
+    struct entry {
+        T      Value;
+        rect_f Rect {};
+        u32    Node {NONE}; //!< NONE for released entries
+        u32    Prev {NONE};
+        u32    Next {NONE}; //!< also links the free list
+    };
+
+    void insert(u32 entry);
+    void link(u32 entry, u32 node);
+    void unlink(u32 entry);
+
+    void split(u32 node);
+    void merge_upwards(u32 node);
+
+    static auto GetQuadrant(node const& node, rect_f const& valueRect) -> i32;
+    static auto ComputeRect(rect_f const& rect, i32 i) -> rect_f;
+    static auto LooseRect(rect_f const& rect) -> rect_f;
+
+    rect_f             _bounds;
+    std::vector<node>  _nodes;
+    std::vector<u32>   _freeChildren; //!< released blocks of four nodes
+    std::vector<entry> _entries;
+    u32                _freeEntry {NONE};
+    usize              _size {0};
+};
+
 }
 
 #include "Quadtree.inl"
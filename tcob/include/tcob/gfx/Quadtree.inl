@@ -7,6 +7,7 @@
 #include "Quadtree.hpp"
 
 #include <algorithm>
+#include <array>
 #include <cassert>
 #include <utility>
 #include <vector>
@@ -324,4 +325,279 @@ inline auto quadtree<T, SplitThreshold, MaxDepth>::node::GetQuadrant(rect_f cons
     }
     return -1;                                           // Not contained in any quadrant
 }
+
+////////////////////////////////////////////////////////////
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline loose_quadtree<T, SplitThreshold, MaxDepth>::loose_quadtree(rect_f const& rect)
+    : _bounds {rect}
+{
+    _nodes.push_back({.Bounds = _bounds});
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::add(T const& value) -> handle
+{
+    u32 idx {_freeEntry};
+    if (idx != NONE) {
+        _freeEntry          = _entries[idx].Next;
+        _entries[idx].Value = value;
+    } else {
+        idx = static_cast<u32>(_entries.size());
+        _entries.push_back({.Value = value});
+    }
+
+    _entries[idx].Rect = value.get_rect();
+    insert(idx);
+    ++_size;
+    return idx;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::update(handle h, T const& value)
+{
+    assert(h < _entries.size() && _entries[h].Node != NONE);
+
+    auto& e {_entries[h]};
+    e.Value = value;
+    e.Rect  = value.get_rect();
+
+    // stay if the value still fits the node and can't move down
+    node const& current {_nodes[e.Node]};
+    point_f const center {e.Rect.center()};
+    bool const fitsNode {e.Node == 0
+                         || (e.Rect.width() <= current.Bounds.width() && e.Rect.height() <= current.Bounds.height()
+                             && center.X >= current.Bounds.left() && center.X < current.Bounds.right()
+                             && center.Y >= current.Bounds.top() && center.Y < current.Bounds.bottom())};
+    if (fitsNode && (current.Children == NONE || GetQuadrant(current, e.Rect) == -1)) { return; }
+
+    u32 const oldNode {e.Node};
+    unlink(h);
+    insert(h);
+    merge_upwards(oldNode);
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::remove(handle h)
+{
+    assert(h < _entries.size() && _entries[h].Node != NONE);
+
+    u32 const oldNode {_entries[h].Node};
+    unlink(h);
+
+    auto& e {_entries[h]};
+    e.Node     = NONE;
+    e.Next     = _freeEntry;
+    _freeEntry = h;
+    --_size;
+
+    merge_upwards(oldNode);
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::clear()
+{
+    _nodes.clear();
+    _nodes.push_back({.Bounds = _bounds});
+    _freeChildren.clear();
+    _entries.clear();
+    _freeEntry = NONE;
+    _size      = 0;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::rebuild()
+{
+    _nodes.clear();
+    _nodes.push_back({.Bounds = _bounds});
+    _freeChildren.clear();
+
+    for (u32 i {0}; i < _entries.size(); ++i) {
+        if (_entries[i].Node != NONE) { link(i, 0); }
+    }
+
+    // children are appended behind their parent, so this splits top-down
+    for (u32 n {0}; n < _nodes.size(); ++n) {
+        if (_nodes[n].Count > SplitThreshold && _nodes[n].Depth < MaxDepth) { split(n); }
+    }
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+template <typename Func>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::query(rect_f const& rect, Func&& func) const
+{
+    std::array<u32, (MaxDepth * 3) + 4> stack {};
+    usize                               top {0};
+    stack[top++] = 0;
+
+    while (top > 0) {
+        node const& n {_nodes[stack[--top]]};
+        for (u32 e {n.First}; e != NONE; e = _entries[e].Next) {
+            if (detail::intersects(rect, _entries[e].Rect)) { func(_entries[e].Value); }
+        }
+
+        if (n.Children == NONE) { continue; }
+        for (u32 i {0}; i < 4; ++i) {
+            if (detail::intersects(rect, LooseRect(_nodes[n.Children + i].Bounds))) { stack[top++] = n.Children + i; }
+        }
+    }
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::query(rect_f const& rect, std::vector<T>& values) const
+{
+    query(rect, [&values](T const& value) { values.push_back(value); });
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::get(handle h) const -> T const&
+{
+    assert(h < _entries.size() && _entries[h].Node != NONE);
+    return _entries[h].Value;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::size() const -> usize
+{
+    return _size;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::bounds() const -> rect_f const&
+{
+    return _bounds;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::insert(u32 entry)
+{
+    rect_f const& rect {_entries[entry].Rect};
+
+    u32 n {0};
+    while (_nodes[n].Children != NONE) {
+        i32 const i {GetQuadrant(_nodes[n], rect)};
+        if (i == -1) { break; }
+        n = _nodes[n].Children + static_cast<u32>(i);
+    }
+
+    link(entry, n);
+    if (_nodes[n].Children == NONE && _nodes[n].Count > SplitThreshold && _nodes[n].Depth < MaxDepth) { split(n); }
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::link(u32 entry, u32 node)
+{
+    auto& e {_entries[entry]};
+    auto& n {_nodes[node]};
+    e.Node = node;
+    e.Prev = NONE;
+    e.Next = n.First;
+    if (n.First != NONE) { _entries[n.First].Prev = entry; }
+    n.First = entry;
+    ++n.Count;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::unlink(u32 entry)
+{
+    auto& e {_entries[entry]};
+    auto& n {_nodes[e.Node]};
+    if (e.Prev != NONE) {
+        _entries[e.Prev].Next = e.Next;
+    } else {
+        n.First = e.Next;
+    }
+    if (e.Next != NONE) { _entries[e.Next].Prev = e.Prev; }
+    --n.Count;
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::split(u32 node)
+{
+    u32 children {0};
+    if (!_freeChildren.empty()) {
+        children = _freeChildren.back();
+        _freeChildren.pop_back();
+    } else {
+        children = static_cast<u32>(_nodes.size());
+        _nodes.resize(_nodes.size() + 4);
+    }
+
+    for (i32 i {0}; i < 4; ++i) {
+        _nodes[children + static_cast<u32>(i)] = {.Bounds = ComputeRect(_nodes[node].Bounds, i), .Parent = node, .Depth = _nodes[node].Depth + 1};
+    }
+    _nodes[node].Children = children;
+
+    // move every value that fits a child, the rest stays here
+    for (u32 e {_nodes[node].First}; e != NONE;) {
+        u32 const next {_entries[e].Next};
+        if (i32 const i {GetQuadrant(_nodes[node], _entries[e].Rect)}; i != -1) {
+            unlink(e);
+            link(e, children + static_cast<u32>(i));
+        }
+        e = next;
+    }
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline void loose_quadtree<T, SplitThreshold, MaxDepth>::merge_upwards(u32 node)
+{
+    if (_nodes[node].Children == NONE) { node = _nodes[node].Parent; }
+
+    // merge at half the threshold, so values moving back and forth don't split and merge all the time
+    while (node != NONE) {
+        auto& n {_nodes[node]};
+        usize count {n.Count};
+        for (u32 i {0}; i < 4; ++i) {
+            auto const& child {_nodes[n.Children + i]};
+            if (child.Children != NONE) { return; }
+            count += child.Count;
+        }
+        if (count > SplitThreshold / 2) { return; }
+
+        u32 const children {n.Children};
+        for (u32 i {0}; i < 4; ++i) {
+            for (u32 e {_nodes[children + i].First}; e != NONE;) {
+                u32 const next {_entries[e].Next};
+                unlink(e);
+                link(e, node);
+                e = next;
+            }
+        }
+        n.Children = NONE;
+        _freeChildren.push_back(children);
+
+        node = n.Parent;
+    }
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::GetQuadrant(node const& node, rect_f const& valueRect) -> i32
+{
+    // a value fits a child if it is at most as large as the child and its center lies inside of it
+    auto const& bounds {node.Bounds};
+    if (valueRect.width() > bounds.width() / 2.0f || valueRect.height() > bounds.height() / 2.0f) { return -1; }
+
+    point_f const center {valueRect.center()};
+    if (center.X < bounds.left() || center.X >= bounds.right() || center.Y < bounds.top() || center.Y >= bounds.bottom()) { return -1; }
+
+    point_f const mid {bounds.center()};
+    return (center.X >= mid.X ? 1 : 0) + (center.Y >= mid.Y ? 2 : 0);
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::ComputeRect(rect_f const& rect, i32 i) -> rect_f
+{
+    size_f const  childSize {rect.Size / 2.0f};
+    point_f const offset {(i & 1) ? childSize.Width : 0.0f, (i & 2) ? childSize.Height : 0.0f};
+    return {rect.Position + offset, childSize};
+}
+
+template <LooseQuadtreeValue T, usize SplitThreshold, usize MaxDepth>
+inline auto loose_quadtree<T, SplitThreshold, MaxDepth>::LooseRect(rect_f const& rect) -> rect_f
+{
+    point_f const halfSize {rect.Size.Width / 2.0f, rect.Size.Height / 2.0f};
+    return {rect.Position - halfSize, rect.Size * 2.0f};
+}
+
 }
@@ -51,6 +51,8 @@ public:
     auto intersect_polyline(polyline_span polygon) const -> std::vector<result>;
     auto intersect_polyline(polyline_span polygon, transform const& xform) const -> std::vector<result>;
 
+    auto intersect_aabb(rect_f const& rect, f64 maxDistance = std::numeric_limits<f64>::max()) const -> std::optional<f64>; //!< entry distance, 0 if the origin is inside
+
 private:
     auto intersect_rect(point_f topLeft, point_f topRight, point_f bottomLeft, point_f bottomRight) const -> std::vector<result>;
     auto intersect_segment(point_d const& rd, point_d const& p0, point_d const& p1) const -> std::optional<f64>;
@@ -0,0 +1,95 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#pragma once
+#include "tcob/tcob_config.hpp"
+
+#include <array>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include "tcob/gfx/Geometry.hpp"
+#include "tcob/gfx/Gfx.hpp"
+#include "tcob/gfx/Material.hpp"
+#include "tcob/gfx/RenderTarget.hpp"
+#include "tcob/gfx/Renderer.hpp"
+#include "tcob/gfx/Stats.hpp"
+#include "tcob/gfx/VertexArray.hpp"
+
+namespace tcob::gfx {
+////////////////////////////////////////////////////////////
+
+class drawable;
+
+////////////////////////////////////////////////////////////
+
+// Collects the geometry of a frame, sorts it by layer, pass index, shader, texture and depth and
+// merges consecutive geometry with equal passes into a single draw call.
+// Within a layer the material wins over submission order; use separate layers where overlapping
+// geometry has to keep its order. Depth sits below pass index, shader and texture in the key, so it only
+// orders geometry that shares all three. Geometry with equal keys keeps submission order,
+// and nothing is sorted across a drawable that is drawn in place.
+class TCOB_API render_queue final : public renderer {
+public:
+    struct batch {
+        pass const*    Pass {nullptr};
+        primitive_type Type {};
+        u32            NumInds {0};
+        u32            OffsetInds {0};
+        drawable*      Drawable {nullptr}; //!< set for drawables without queue support, drawn in place
+    };
+
+    render_queue();                                  //!< reports to the statistics of the render system
+    explicit render_queue(render_statistics* stats); //!< nullptr disables reporting
+
+    void submit(geometry_data const& gd, material const& material, isize passIndex, u8 layer = 0, f32 depth = 0.0f);
+    void submit(std::span<quad const> quads, material const& material, isize passIndex, u8 layer = 0, f32 depth = 0.0f);
+    void submit(drawable& drawable, u8 layer = 0, f32 depth = 0.0f); //!< drawn in place, ends the current batch
+
+    void clear(); //!< call once per frame, also forgets the shader and texture ids
+
+    void prepare();                                                               //!< sorts and merges the submitted geometry, called by render_to_target
+    auto batches() const -> std::span<batch const>;                               //!< valid after prepare
+    auto draw_call_count() const -> u32;                                          //!< draw calls of the prepared batches, drawables not included
+    auto state_change_count() const -> u32;                                       //!< pass binds of the prepared batches, drawables not included
+    auto make_key(pass const& pass, isize passIndex, u8 layer, f32 depth) -> u64; //!< layer:8 | pass index:4 | shader:14 | texture:14 | depth:24, depth is clamped to [0, 1]
+
+private:
+    void on_render_to_target(render_target& target) override;
+
+    void submit_command(pass const& pass, isize passIndex, primitive_type type, u32 numInds, u8 layer, f32 depth);
+    auto resource_id(void const* ptr) -> u64;
+
+    struct command {
+        u64            Key {0};
+        u32            Segment {0}; //!< sorted before the key, bumped by drawables drawn in place
+        pass const*    Pass {nullptr};
+        primitive_type Type {};
+        u32            OffsetVerts {0};
+        u32            NumInds {0};
+        u32            OffsetInds {0}; //!< into _commandIndices
+        drawable*      Drawable {nullptr};
+    };
+
+    std::vector<vertex>  _verts;
+    std::vector<u32>     _commandIndices;
+    std::vector<command> _commands;
+    std::vector<u32>     _order;
+
+    std::vector<u32>   _indices; //!< sorted and rebased to _verts
+    std::vector<batch> _batches;
+    bool               _isPrepared {false};
+
+    std::unordered_map<void const*, u64> _resourceIds;
+    std::array<u32, 256>                 _segments {}; //!< per layer
+
+    render_statistics* _stats {nullptr};
+    usize              _vertCapacity {0};
+    usize              _indCapacity {0};
+    vertex_array       _vertexArray;
+};
+
+}
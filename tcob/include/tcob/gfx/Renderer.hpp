@@ -76,6 +76,28 @@ private:
 
 ////////////////////////////////////////////////////////////
 
+class TCOB_API indexed_quad_renderer final : public renderer {
+public:
+    explicit indexed_quad_renderer(buffer_usage_hint usage);
+
+    void resize(usize quadCount);                                      //!< discards all quads and the draw order
+    void update_geometry(std::span<quad const> quads, usize quadOffset); //!< overwrites a range of the stored quads
+    void set_order(std::span<u32 const> quadIndices);                  //!< stored quads to draw, in this order
+    void set_pass(pass const* pass);
+
+private:
+    void on_render_to_target(render_target& target) override;
+
+    pass const* _pass {nullptr};
+    usize       _capacity {0};
+    usize       _numIndices {0};
+
+    std::vector<u32> _indices;
+    vertex_array     _vertexArray;
+};
+
+////////////////////////////////////////////////////////////
+
 class TCOB_API polygon_renderer final : public renderer {
 public:
     explicit polygon_renderer(buffer_usage_hint usage);
@@ -101,28 +123,61 @@ class TCOB_API batch_polygon_renderer final : public renderer {
 public:
     batch_polygon_renderer();
 
-    void add_geometry(geometry_data const& gd, pass const* pass);
+    auto add_geometry(geometry_data const& gd, pass const* pass) -> u32;               //!< appends, the returned slot stays valid until removed or reset
+    auto update_geometry(u32 slot, geometry_data const& gd, pass const* pass) -> bool; //!< rewrites the slot in place, false if the size, type or pass changed
+    void remove_geometry(u32 slot);                                                    //!< leaves a hole, holes get compacted once they make up a quarter of the buffer or split too many batches
     void reset_geometry();
 
 private:
     void on_render_to_target(render_target& target) override;
 
-    std::vector<u32>    _indices;
-    std::vector<vertex> _verts;
+    struct slot;
 
-    vertex_array _vertexArray;
+    void upload();
+    void compact();
+    void rebuild_batches();
+    void add_to_batches(slot const& s);
 
-    struct batch {
+    struct slot {
         pass const*    Pass {nullptr};
         primitive_type Type {};
         u32            NumVerts {0};
         u32            NumInds {0};
         u32            OffsetVerts {0};
         u32            OffsetInds {0};
+        bool           Alive {false};
+    };
+
+    struct batch {
+        pass const*    Pass {nullptr};
+        primitive_type Type {};
+        u32            NumInds {0};
+        u32            OffsetInds {0};
     };
 
-    batch              _currentBatch;
+    struct range {
+        usize Offset {0};
+        usize Count {0};
+    };
+
+    std::vector<u32>    _indices;
+    std::vector<vertex> _verts;
+
+    std::vector<slot>  _slots;
+    std::vector<u32>   _order; //!< slots in buffer order, including dead ones until the next compaction
+    std::vector<u32>   _freeSlots;
     std::vector<batch> _batches;
+    bool               _batchesDirty {false};
+    usize              _deadVerts {0};
+    usize              _deadSlots {0}; //!< each one can split a batch
+
+    std::vector<range> _dirtyVerts;
+    std::vector<range> _dirtyInds;
+    bool               _uploadAll {false};
+    usize              _vertCapacity {0};
+    usize              _indCapacity {0};
+
+    vertex_array _vertexArray;
 };
 
 ////////////////////////////////////////////////////////////
@@ -24,6 +24,14 @@ public:
     auto best_FPS() const -> f32;
     auto worst_FPS() const -> f32;
 
+    // Only render queues report, so drawables drawn in place by a queue and everything
+    // rendered through other renderers are missing from these counts.
+    auto draw_calls() const -> u32;    //!< reported by render queues in the last frame
+    auto state_changes() const -> u32; //!< pass binds reported by render queues in the last frame
+
+    void add_draw_calls(u32 count);
+    void add_state_changes(u32 count);
+
     void update(milliseconds delta);
     void reset();
 
@@ -35,5 +43,10 @@ private:
     f32 _worstFrames {std::numeric_limits<f32>::max()};
     f32 _bestFrames {0};
     f32 _time {0};
+
+    u32 _drawCalls {0};
+    u32 _stateChanges {0};
+    u32 _frameDrawCalls {0};
+    u32 _frameStateChanges {0};
 };
 }
@@ -9,6 +9,7 @@
 #include <memory>
 #include <span>
 #include <unordered_map>
+#include <vector>
 
 #include "tcob/core/Common.hpp"
 #include "tcob/core/Interfaces.hpp"
@@ -22,6 +23,32 @@
 namespace tcob::gfx {
 ////////////////////////////////////////////////////////////
 
+// Lookups never touch the global name table; only inserting a new region interns its name.
+class TCOB_API texture_region_map final {
+public:
+    auto operator[](string const& name) -> texture_region&; //!< inserts a default region if missing
+    auto operator[](texture_region_handle const& handle) -> texture_region&;
+
+    auto contains(string const& name) const -> bool;
+    auto contains(texture_region_handle const& handle) const -> bool;
+
+    auto find(string const& name) const -> texture_region const*;           //!< nullptr if missing
+    auto find(texture_region_handle const& handle) const -> texture_region const*; //!< nullptr if missing
+
+    auto size() const -> usize;
+
+private:
+    auto index_of(texture_region_handle const& handle) const -> u32;
+    auto insert(string const& name, texture_region_handle const& handle) -> texture_region&;
+
+    std::vector<texture_region>        _regions {};
+    std::vector<texture_region_handle> _handles {}; //!< one per region, keeps the ids in _slots from being reused
+    std::unordered_map<string, u32>    _names {};   //!< region index per name
+    std::vector<u32>                   _slots {};   //!< region index per handle id
+};
+
+////////////////////////////////////////////////////////////
+
 class TCOB_API texture {
 public:
     ////////////////////////////////////////////////////////////
@@ -84,7 +111,7 @@ public:
 private:
     std::unique_ptr<render_backend::texture_base> _impl;
 
-    std::unordered_map<string, texture_region> _regions {}; // perfcrit
+    texture_region_map _regions {};
 
     size_i _size {size_i::Zero};
     format _format {format::RGBA8};
@@ -35,6 +35,8 @@ protected:
     void on_draw_to(render_target& target) final;
 
 private:
+    texture_region_handle _textureRegion; //!< interned TextureRegion
+
     quad          _quad;
     quad_renderer _renderer {buffer_usage_hint::StreamDraw};
 };
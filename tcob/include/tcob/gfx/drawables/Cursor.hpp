@@ -47,7 +47,8 @@ protected:
 
 private:
     struct cursor_mode {
-        point_i Hotspot {point_i::Zero};
+        point_i               Hotspot {point_i::Zero};
+        texture_region_handle Region {};
     };
 
     std::unordered_map<string, cursor_mode> _modes {};
@@ -27,11 +27,14 @@ public:
     auto is_visible() const -> bool;
 
     void draw_to(render_target& target);
+    void submit_to(render_queue& queue, render_target& target, u8 layer = 0); //!< drawables without queue support get drawn in place
 
 protected:
     virtual void on_draw_to(render_target& target) = 0;
     virtual auto can_draw() const -> bool          = 0;
 
+    virtual auto on_submit_to(render_queue& queue, render_target& target, u8 layer) -> bool; //!< false if the drawable has to be drawn in place
+
     virtual void on_visibility_changed();
 
 private:
@@ -8,8 +8,9 @@
 
 #include <any>
 #include <memory>
-#include <mutex>
 #include <optional>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "tcob/core/AngleUnits.hpp"
@@ -42,7 +43,7 @@ class shadow_caster;
 struct light_collision {
     point_f              Point {};
     f64                  Distance {};
-    usize                CollisionCount {};
+    usize                CollisionCount {}; //!< number of times the ray hits the outline of the nearest caster
     light_source const*  Source {nullptr};
     shadow_caster const* Caster {nullptr};
 };
@@ -74,6 +75,7 @@ protected:
 private:
     lighting_system*             _parent;
     bool                         _isDirty {true};
+    bool                         _isStaticDirty {true};
     std::vector<light_collision> _collisionResult;
 };
 
@@ -89,6 +91,7 @@ public:
 
     signal<light_collision const> Hit;
     prop<polyline>                Polygon;
+    prop<bool>                    Static {false}; //!< static casters are cached per light, moving them is more expensive
 
 protected:
     shadow_caster(lighting_system* parent);
@@ -97,6 +100,8 @@ protected:
 private:
     lighting_system* _parent;
     rect_f           _bounds;
+    bool             _isStatic {false};
+    u32              _treeHandle {0}; //!< dynamic casters only, valid while _bounds is not empty
 };
 
 ////////////////////////////////////////////////////////////
@@ -145,17 +150,50 @@ private:
         auto operator==(quadtree_node const& other) const -> bool { return Caster == other.Caster; }
     };
 
-    struct shadow_caster_points {
-        polyline_span        Points {};
+    struct sweep_segment {
+        point_d              A {}; //!< relative to the light, the sweep reaches A first
+        point_d              B {}; //!< relative to the light
         shadow_caster const* Caster {nullptr};
     };
 
+    enum class sweep_event_type : u8 {
+        Sample,
+        Start,
+        End
+    };
+
+    struct sweep_event {
+        f64              Angle {0};
+        u32              Segment {0};
+        sweep_event_type Type {sweep_event_type::Sample};
+    };
+
+    // static part of the sweep input, cached per light
+    struct static_sweep {
+        std::vector<sweep_segment> Segments;
+        std::vector<sweep_event>   Events; //!< sorted by angle
+        std::vector<u32>           Active; //!< segments crossing the 0 degree ray
+        bool                       LightInside {false};
+    };
+
+    // per worker thread, reused across frames
+    struct sweep_scratch {
+        std::vector<sweep_segment> Segments;
+        std::vector<sweep_event>   DynamicEvents;
+        std::vector<sweep_event>   Events;
+        std::vector<u32>           Active;
+    };
+
     void rebuild_quadtree();
     void mark_lights_dirty();
+    void mark_lights_dirty(rect_f const& area, bool staticCasters);
+
+    void add_to_tree(shadow_caster& shadow);
+    void remove_from_tree(shadow_caster const& shadow, rect_f const& bounds, bool isStatic);
+    auto light_bounds(light_source const& light) const -> rect_f;
 
-    void cast_ray(light_source& light, f32 lightRange);
-    void build_geometry(light_source& light, f32 lightRange, u32& indOffset);
-    auto collect_angles(light_source& light, bool lightInsideShadowCaster, std::vector<shadow_caster_points> const& casterPoints) const -> std::vector<f64>;
+    void compute_visibility(light_source& light, static_sweep& cache, sweep_scratch& scratch) const;
+    void build_geometry(light_source& light, f32 lightRange);
 
     std::vector<std::unique_ptr<light_source>>  _lightSources {};
     std::vector<std::unique_ptr<shadow_caster>> _shadowCasters {};
@@ -163,15 +201,20 @@ private:
     bool _isDirty {false};
     bool _updateGeometry {false};
 
-    polygon_renderer _renderer {buffer_usage_hint::DynamicDraw};
-    geometry_store   _store;
+    polygon_renderer    _renderer {buffer_usage_hint::DynamicDraw};
+    geometry_store      _store;
+    std::vector<vertex> _verts;
+    std::vector<u32>    _inds;
 
     asset_owner_ptr<material> _material;
 
-    std::mutex _mutex {};
-    bool       _multiThreaded;
+    std::unordered_map<light_source const*, static_sweep> _staticSweeps;
+    std::vector<std::pair<light_source*, static_sweep*>>  _dirtyLights;
+    std::vector<sweep_scratch>                            _sweepScratch;
+    bool                                                  _multiThreaded;
 
-    std::unique_ptr<quadtree<quadtree_node>> _quadTree;
+    std::unique_ptr<quadtree<quadtree_node>>       _staticTree;  //!< rarely changes, queried once per static sweep
+    std::unique_ptr<loose_quadtree<quadtree_node>> _dynamicTree; //!< updated in place as casters move
 };
 
 }
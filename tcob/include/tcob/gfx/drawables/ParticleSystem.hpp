@@ -8,7 +8,6 @@
 
 #include <any>
 #include <memory>
-#include <mutex>
 #include <optional>
 #include <utility>
 #include <vector>
@@ -25,6 +24,7 @@
 #include "tcob/core/random/Random.hpp"
 #include "tcob/gfx/Geometry.hpp"
 #include "tcob/gfx/Gfx.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/Renderer.hpp"
 #include "tcob/gfx/Transform.hpp"
 #include "tcob/gfx/drawables/Drawable.hpp"
@@ -37,6 +37,31 @@ using min_max = std::pair<T, T>;
 
 ////////////////////////////////////////////////////////////
 
+class soa_point_particle_system;
+
+////////////////////////////////////////////////////////////
+
+namespace detail {
+    // indices of dead particles found by one worker thread, padded to avoid false sharing
+    struct alignas(64) particle_kill_list {
+        std::vector<isize> Indices;
+    };
+
+    void drain_kill_lists(std::vector<particle_kill_list>& lists, auto&& func);
+
+    // interns the template's region name and only resolves it again when the name changes
+    class TCOB_API particle_region_cache {
+    public:
+        auto get(pass const& pass, string const& name) -> texture_region;
+
+    private:
+        string                _name;
+        texture_region_handle _handle;
+    };
+}
+
+////////////////////////////////////////////////////////////
+
 template <typename T>
 struct particle_event {
     T&           Particle;
@@ -96,17 +121,20 @@ protected:
     auto can_draw() const -> bool override;
 
     void on_draw_to(render_target& target) override;
+    auto on_submit_to(render_queue& queue, render_target& target, u8 layer) -> bool override; //!< only quad particles support the queue
 
 private:
+    void update_geometry();
+
     renderer_type              _renderer {buffer_usage_hint::DynamicDraw};
     std::vector<geometry_type> _geometry;
 
     std::vector<std::unique_ptr<emitter_type>> _emitters {};
     std::vector<particle_type>                 _particles {};
     isize                                      _aliveParticleCount {0};
+    std::vector<detail::particle_kill_list>    _deadParticles {}; //!< one kill list per worker thread
 
-    std::mutex _mutex {};
-    bool       _multiThreaded;
+    bool _multiThreaded;
 
     bool _isRunning {false};
 };
@@ -207,14 +235,97 @@ public:
     void reset();
 
     void emit(particle_system<point_particle_emitter>& system, milliseconds deltaTime);
+    void emit(soa_point_particle_system& system, milliseconds deltaTime);
 
 private:
+    auto next_particle_count(milliseconds deltaTime) -> i32;
+    void init_particle(point_particle& particle, texture_region const& region);
+
+    detail::particle_region_cache _region;
+
     rng          _rng;
     milliseconds _remainingLife {1000};
     f64          _emissionDiff {0};
     bool         _alive {true};
 };
 
+////////////////////////////////////////////////////////////
+
+// Structure-of-arrays storage for point particles. Each attribute lives in its own stream,
+// so the update kernel runs over contiguous floats the compiler can vectorize.
+class TCOB_API point_particle_streams final {
+public:
+    std::vector<f32> PositionX;
+    std::vector<f32> PositionY;
+    std::vector<f32> OriginX;
+    std::vector<f32> OriginY;
+    std::vector<f32> VelocityX;
+    std::vector<f32> VelocityY;
+    std::vector<f32> AccelerationX; //!< linear acceleration + gravity
+    std::vector<f32> AccelerationY; //!< linear acceleration + gravity
+    std::vector<f32> LinearDamping;
+    std::vector<f32> RadialAcceleration;
+    std::vector<f32> TangentialAcceleration;
+    std::vector<f32> RemainingLife; //!< in milliseconds
+
+    std::vector<color> Color;
+    std::vector<uv>    TexCoords;
+
+    auto size() const -> isize;
+    auto empty() const -> bool;
+
+    void reserve(isize count);
+    void clear();
+
+    void push_back(point_particle const& particle);
+    void swap_remove(isize index); //!< moves the last particle into index
+};
+
+////////////////////////////////////////////////////////////
+
+// Point particle system using point_particle_streams. Updating the particles and
+// generating their vertices happens in a single pass, there are no per-particle callbacks.
+class TCOB_API soa_point_particle_system final : public drawable, public updatable {
+public:
+    explicit soa_point_particle_system(bool multiThreaded = false, isize reservedParticleCount = 0);
+
+    prop<asset_ptr<material>> Material;
+
+    auto is_running() const -> bool;
+
+    void start();
+    void restart();
+    void stop();
+
+    auto create_emitter(auto&&... args) -> point_particle_emitter&;
+
+    void remove_emitter(point_particle_emitter const& emitter);
+    void clear_emitters();
+
+    auto particle_count() const -> isize;
+
+    auto streams() -> point_particle_streams&;
+    auto streams() const -> point_particle_streams const&;
+
+protected:
+    void on_update(milliseconds deltaTime) override;
+
+    auto can_draw() const -> bool override;
+
+    void on_draw_to(render_target& target) override;
+
+private:
+    point_renderer      _renderer {buffer_usage_hint::DynamicDraw};
+    std::vector<vertex> _vertices;
+
+    std::vector<std::unique_ptr<point_particle_emitter>> _emitters {};
+    point_particle_streams                               _particles {};
+    std::vector<detail::particle_kill_list>              _deadParticles {}; //!< one kill list per worker thread
+
+    bool _multiThreaded;
+    bool _isRunning {false};
+};
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
@@ -302,6 +413,8 @@ public:
     void emit(particle_system<quad_particle_emitter>& system, milliseconds deltaTime);
 
 private:
+    detail::particle_region_cache _region;
+
     rng          _randomGen;
     milliseconds _remainingLife {1000};
     f64          _emissionDiff {0};
@@ -8,11 +8,9 @@
 
 #include <algorithm>
 #include <cassert>
-#include <functional>
+#include <concepts>
 #include <memory>
-#include <mutex>
 #include <optional>
-#include <set>
 #include <tuple>
 #include <utility>
 
@@ -20,12 +18,31 @@
 #include "tcob/core/Serialization.hpp"
 #include "tcob/core/ServiceLocator.hpp"
 #include "tcob/core/TaskManager.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 
 namespace tcob::gfx {
 
 ////////////////////////////////////////////////////////
 
+// Workers claim ranges in ascending order, so every kill list is sorted. Merging the lists
+// from the back visits the indices in descending order, which keeps swap-with-last removal valid.
+inline void detail::drain_kill_lists(std::vector<particle_kill_list>& lists, auto&& func)
+{
+    for (;;) {
+        std::vector<isize>* next {nullptr};
+        for (auto& list : lists) {
+            if (!list.Indices.empty() && (!next || list.Indices.back() > next->back())) { next = &list.Indices; }
+        }
+        if (!next) { break; }
+
+        func(next->back());
+        next->pop_back();
+    }
+}
+
+////////////////////////////////////////////////////////
+
 template <typename Emitter>
 particle_system<Emitter>::particle_system(bool multiThreaded, isize reservedParticleCount)
     : _multiThreaded {multiThreaded}
@@ -123,26 +140,25 @@ inline void particle_system<Emitter>::on_update(milliseconds deltaTime)
         emitter->emit(*this, deltaTime);
     }
 
-    std::set<isize, std::greater<>> toBeDeactivated;
+    auto& tm {locate_service<task_manager>()};
+    _deadParticles.resize(static_cast<usize>(std::max<isize>(1, tm.thread_count())));
 
-    locate_service<task_manager>().run_parallel(
+    tm.run_parallel(
         [&](par_task const& ctx) {
+            auto& dead {_deadParticles[static_cast<usize>(ctx.Thread)].Indices};
             for (isize i {ctx.Start}; i < ctx.End; ++i) {
                 auto& particle {_particles[i]};
                 if (particle.is_alive()) {
                     ParticleUpdate({.Particle = particle, .DeltaTime = deltaTime});
                     particle.update(deltaTime);
                 } else {
-                    std::scoped_lock lock {_mutex};
-                    toBeDeactivated.insert(i);
+                    dead.push_back(i);
                 }
             }
         },
         _aliveParticleCount, _multiThreaded ? 64 : _aliveParticleCount);
 
-    for (auto const& i : toBeDeactivated) {
-        deactivate_particle(_particles[i]);
-    }
+    detail::drain_kill_lists(_deadParticles, [this](isize i) { deactivate_particle(_particles[i]); });
 }
 
 template <typename Emitter>
@@ -152,7 +168,7 @@ inline auto particle_system<Emitter>::can_draw() const -> bool
 }
 
 template <typename Emitter>
-inline void particle_system<Emitter>::on_draw_to(render_target& target)
+inline void particle_system<Emitter>::update_geometry()
 {
     _geometry.resize(_aliveParticleCount);
 
@@ -163,6 +179,12 @@ inline void particle_system<Emitter>::on_draw_to(render_target& target)
             }
         },
         _aliveParticleCount, _multiThreaded ? 64 : _aliveParticleCount);
+}
+
+template <typename Emitter>
+inline void particle_system<Emitter>::on_draw_to(render_target& target)
+{
+    update_geometry();
 
     for (isize i {0}; i < Material->pass_count(); ++i) {
         auto const& pass {Material->get_pass(i)};
@@ -172,6 +194,28 @@ inline void particle_system<Emitter>::on_draw_to(render_target& target)
     }
 }
 
+template <typename Emitter>
+inline auto particle_system<Emitter>::on_submit_to(render_queue& queue, render_target& /* target */, u8 layer) -> bool
+{
+    if constexpr (std::same_as<geometry_type, quad>) {
+        update_geometry();
+
+        for (isize i {0}; i < Material->pass_count(); ++i) {
+            queue.submit({_geometry.data(), static_cast<usize>(_aliveParticleCount)}, **Material, i, layer);
+        }
+        return true;
+    } else {
+        return false;
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+inline auto soa_point_particle_system::create_emitter(auto&&... args) -> point_particle_emitter&
+{
+    return *_emitters.emplace_back(std::make_unique<point_particle_emitter>(args...));
+}
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
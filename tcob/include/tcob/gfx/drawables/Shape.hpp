@@ -10,6 +10,7 @@
 #include <memory>
 #include <optional>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "tcob/core/Color.hpp"
@@ -18,6 +19,7 @@
 #include "tcob/core/Property.hpp"
 #include "tcob/core/Rect.hpp"
 #include "tcob/core/assets/Asset.hpp"
+#include "tcob/gfx/AABBTree.hpp"
 #include "tcob/gfx/Geometry.hpp"
 #include "tcob/gfx/Gfx.hpp"
 #include "tcob/gfx/Material.hpp"
@@ -33,6 +35,8 @@ namespace tcob::gfx {
 ////////////////////////////////////////////////////////////
 
 class TCOB_API shape : public transformable, public updatable, public non_copyable {
+    friend class shape_batch;
+
 public:
     shape();
 
@@ -66,12 +70,20 @@ protected:
 
     void mark_dirty();
     void mark_clean();
+    void mark_geometry_changed(); //!< vertices changed without the shape being dirty, e.g. scrolled texture coordinates
 
     auto get_texture_region(pass const& pass) const -> texture_region;
 
 private:
-    bool _isDirty {false};
-    bool _visible {true};
+    texture_region_handle _textureRegion; //!< interned TextureRegion
+
+    bool             _isDirty {false};
+    bool             _isGeometryChanged {false};
+    bool             _visible {true};
+    u32              _batchHandle {0};
+    std::vector<u32> _batchSlots {}; //!< geometry slots in the batch renderer, one per pass
+    bool             _batchPending {false};
+    bool             _batchQueued {false}; //!< already in the dirty list of the batch
 };
 
 ////////////////////////////////////////////////////////////
@@ -186,10 +198,13 @@ public:
     auto get_shape_at(isize index) const -> shape&;
 
     auto intersect(ray const& ray, u32 mask = 0xFFFFFFFF) const -> std::unordered_map<shape*, std::vector<ray::result>>;
-    auto intersect(rect_f const& rect, u32 mask = 0xFFFFFFFF) const -> std::vector<shape*>;
+    auto intersect(rect_f const& rect, u32 mask = 0xFFFFFFFF) const -> std::vector<shape*>;                             //!< in no particular order
+    auto intersect_first(ray const& ray, u32 mask = 0xFFFFFFFF) const -> std::optional<std::pair<shape*, ray::result>>; //!< nearest hit only
 
     void clear();
 
+    void rebuild_index(); //!< happens automatically once insertions and removals touched half of the index
+
 protected:
     void on_update(milliseconds deltaTime) override;
 
@@ -197,9 +212,17 @@ protected:
     void on_draw_to(render_target& target) override;
 
 private:
-    bool                                _isDirty {false};
+    void rebuild_geometry();
+    void add_geometry(shape& shape);
+    auto update_geometry(shape& shape) -> bool;
+
     std::vector<std::unique_ptr<shape>> _children {};
+    aabb_tree<shape*>                   _index {};         //!< refit with the shape bounds during update
+    usize                               _indexChanges {0}; //!< insertions and removals since the last rebuild
     batch_polygon_renderer              _renderer {};
+    std::vector<shape*>                 _dirtyShapes {};
+    std::vector<shape*>                 _pendingShapes {}; //!< created since the last draw, appended to the renderer
+    bool                                _layoutDirty {false};
 };
 
 }
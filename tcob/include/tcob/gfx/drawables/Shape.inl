@@ -13,7 +13,12 @@ namespace tcob::gfx {
 template <std::derived_from<shape> T>
 inline auto shape_batch::create_shape() -> T&
 {
-    return static_cast<T&>(*_children.emplace_back(std::make_unique<T>()));
+    auto& retValue {static_cast<T&>(*_children.emplace_back(std::make_unique<T>()))};
+    retValue._batchHandle  = _index.add(retValue.aabb(), &retValue);
+    ++_indexChanges;
+    retValue._batchPending = true;
+    _pendingShapes.push_back(&retValue);
+    return retValue;
 }
 
 }
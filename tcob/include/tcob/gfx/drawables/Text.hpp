@@ -19,6 +19,7 @@
 #include "tcob/gfx/Geometry.hpp"
 #include "tcob/gfx/Gfx.hpp"
 #include "tcob/gfx/Material.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 #include "tcob/gfx/Renderer.hpp"
 #include "tcob/gfx/ShaderProgram.hpp"
@@ -57,6 +58,7 @@ protected:
 
     auto can_draw() const -> bool override;
     void on_draw_to(render_target& target) override;
+    auto on_submit_to(render_queue& queue, render_target& target, u8 layer) -> bool override;
 
     auto pivot() const -> point_f override;
     void on_transform_changed() override;
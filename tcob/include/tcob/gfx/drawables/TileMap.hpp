@@ -20,7 +20,9 @@
 #include "tcob/core/Size.hpp"
 #include "tcob/core/assets/Asset.hpp"
 #include "tcob/gfx/Geometry.hpp"
+#include "tcob/gfx/Gfx.hpp"
 #include "tcob/gfx/Material.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 #include "tcob/gfx/Renderer.hpp"
 #include "tcob/gfx/drawables/Drawable.hpp"
@@ -55,8 +57,13 @@ public:
     prop<bool>               Visible {true};
     prop<render_direction>   RenderDirection {render_direction::RightDown};
 
+    auto get_tile(point_i pos) const -> tile_index_t;
+    void set_tile(point_i pos, tile_index_t idx); //!< only rebuilds the chunk containing the tile
+
 private:
     tilemap_layer(tilemap_base* parent);
+
+    tilemap_base* _parent;
 };
 
 ////////////////////////////////////////////////////////////
@@ -68,6 +75,8 @@ public:
     tilemap_base();
     ~tilemap_base() override = default;
 
+    static constexpr i32 ChunkSize {32};
+
     prop<asset_ptr<material>> Material;
     prop<point_f>             Position;
 
@@ -84,19 +93,53 @@ protected:
 
     auto can_draw() const -> bool override;
     void on_draw_to(render_target& target) override;
+    auto on_submit_to(render_queue& queue, render_target& target, u8 layer) -> bool override;
 
     void mark_dirty();
 
 private:
+    struct chunk {
+        rect_i                         Tiles {};      //!< covered tiles in layer coordinates
+        rect_f                         Bounds {};     //!< world space bounds of the quads
+        std::vector<std::vector<quad>> Quads {};      //!< quads per pass, empty tiles are skipped
+        std::vector<u32>               RowStarts {};  //!< first quad of each tile row, in render direction order
+        u32                            QuadOffset {}; //!< start of the chunk's fixed range in the vertex buffers
+        bool                           Dirty {true};
+        bool                           Uploaded {false};
+    };
+
+    struct segment {
+        chunk const* Chunk {nullptr};
+        u32          First {0};
+        u32          Count {0};
+    };
+
     void notify_layer_changed(tilemap_layer* layer);
+    void notify_layer_visibility_changed();
+    void notify_tile_changed(tilemap_layer* layer, point_i pos);
+
+    void create_chunks(tilemap_layer const& layer, grid<chunk>& chunks) const;
+    void build_chunk(tilemap_layer const& layer, chunk& chunk) const;
+    void collect_visible_chunks(rect_f const& viewport);
+    void update_visible_chunks(render_target& target);
+    void upload_chunks();
 
     virtual void setup_quad(pass const& pass, quad& q, point_i coord, tile_index_t idx) const = 0;
 
     std::vector<std::unique_ptr<tilemap_layer>> _layers {};
 
-    quad_renderer                                _renderer;
-    std::unordered_map<isize, std::vector<quad>> _quads {};
-    bool                                         _isDirty {true};
+    std::unordered_map<tilemap_layer const*, grid<chunk>> _chunks {};
+    std::vector<chunk const*>                             _visibleChunks {};
+    std::vector<segment>                                  _visibleSegments {}; //!< visible quads in draw order
+    rect_f                                                _visibleViewport {};
+    bool                                                  _isDirty {true};
+    bool                                                  _isVisibleDirty {true};
+
+    std::vector<std::unique_ptr<indexed_quad_renderer>> _renderers {}; //!< one per pass, every chunk keeps its range
+    std::vector<u32>                                    _drawOrder {};
+    bool                                                _isLayoutDirty {true};
+    bool                                                _isUploadDirty {true};
+    bool                                                _isOrderDirty {true};
 };
 
 ////////////////////////////////////////////////////////////
@@ -116,6 +159,8 @@ public:
 
 private:
     void setup_quad(pass const& pass, quad& q, point_i coord, tile_index_t idx) const override;
+
+    std::unordered_map<tile_index_t, texture_region_handle> _tileRegions {}; //!< interned once per tileset
 };
 
 ////////////////////////////////////////////////////////////
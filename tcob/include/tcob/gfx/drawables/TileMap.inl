@@ -20,7 +20,11 @@ template <typename G>
 inline tilemap<G>::tilemap()
 {
     Grid.Changed.connect([this](auto const&) { mark_dirty(); });
-    Tileset.Changed.connect([this](auto const&) { mark_dirty(); });
+    Tileset.Changed.connect([this](auto const& value) {
+        _tileRegions.clear();
+        for (auto const& [idx, tile] : value) { _tileRegions[idx] = texture_region_handle {tile.TextureRegion}; }
+        mark_dirty();
+    });
 }
 
 template <typename G>
@@ -36,7 +40,10 @@ inline void tilemap<G>::setup_quad(pass const& pass, quad& q, point_i coord, til
         geometry::set_color(q, colors::Transparent);
     } else {
         geometry::set_color(q, tile.Color);
-        geometry::set_texcoords(q, pass, tile.TextureRegion);
+
+        static texture_region_handle const noRegion {};
+        auto const                         it {_tileRegions.find(idx)};
+        geometry::set_texcoords(q, pass, it != _tileRegions.end() ? it->second : noRegion);
     }
 }
 
@@ -136,6 +136,8 @@ public:
     auto position() const -> point_f;
     auto rotation() const -> radian_f;
 
+    auto interpolated_transform() const -> body_transform; //!< between the last two steps, see world::FixedTimeStep
+
     auto world_to_local_point(point_f pos) const -> point_f;
     auto local_to_world_point(point_f pos) const -> point_f;
     auto world_to_local_vector(point_f pos) const -> point_f;
@@ -181,10 +183,17 @@ public:
 private:
     body(world& world, detail::b2d_world* b2dWorld, body_transform const& xform, settings const& bodySettings);
 
+    auto get_transform() const -> body_transform;
+    void set_transform(body_transform const& value);
+
     std::unique_ptr<detail::b2d_body>   _impl;
     world&                              _world;
     std::vector<std::unique_ptr<shape>> _shapes;
     std::vector<std::unique_ptr<chain>> _chains;
+
+    body_transform _previousTransform; //!< before the last step that moved the body
+    body_transform _currentTransform;  //!< after the last step that moved the body
+    u64            _lastMoveStep {0};
 };
 
 template <typename T>
@@ -7,6 +7,7 @@
 #include "tcob/tcob_config.hpp"
 
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <vector>
 
@@ -128,6 +129,10 @@ public:
         /// Enable continuous collision
         bool EnableContinuous {true};
 
+        /// Queue Box2D tasks on the task_manager and let the solver overlap them, instead of
+        /// finishing each task before the next one starts. Off until a multicore measurement shows a gain.
+        bool EnableAsyncTasks {false};
+
         auto constexpr Members();
     };
 
@@ -135,7 +140,9 @@ public:
     explicit world(settings const& settings);
     ~world() override;
 
-    i32 SubSteps {4};
+    i32                         SubSteps {4};
+    std::optional<milliseconds> FixedTimeStep {};      //!< if set, frame time is accumulated and consumed in steps of this size
+    i32                         MaxStepsPerUpdate {8}; //!< bounds the cost per update, excess time is dropped
 
     prop_fn<point_f> Gravity;
     prop_fn<f32>     RestitutionThreshold;
@@ -148,6 +155,9 @@ public:
 
     auto awake_body_count() const -> i32;
 
+    auto interpolation_alpha() const -> f32; //!< progress from the last fixed step towards the next one
+    auto step_count() const -> u64;
+
     template <typename T>
     auto create_joint(auto&& jointSettings) -> T&;
     void remove_joint(joint const& joint);
@@ -169,9 +179,14 @@ private:
     void on_update(milliseconds deltaTime) override;
 
     void remove_joints(body const& body);
+    void step(milliseconds deltaTime);
 
     std::unique_ptr<detail::b2d_world> _impl;
 
+    milliseconds _accumulator {0};
+    f32          _alpha {1.0f};
+    u64          _stepCount {0};
+
     std::vector<std::unique_ptr<body>>  _bodies;
     std::vector<std::unique_ptr<joint>> _joints;
 };
@@ -194,6 +209,7 @@ auto constexpr world::settings::Members()
         member<&world::settings::MaximumLinearSpeed> {"maximum_linear_speed"},
         member<&world::settings::EnableSleeping> {"enable_sleeping"},
         member<&world::settings::EnableContinuous> {"enable_continuous"},
+        member<&world::settings::EnableAsyncTasks> {"enable_async_tasks"},
     };
 }
 
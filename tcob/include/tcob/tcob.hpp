@@ -9,6 +9,8 @@
 #include <tcob/app/Platform.hpp>
 #include <tcob/app/Scene.hpp>
 
+#include <tcob/ai/FlowField.hpp>
+#include <tcob/ai/PathService.hpp>
 #include <tcob/ai/Pathfinding.hpp>
 
 #include <tcob/audio/Buffer.hpp>
@@ -38,6 +40,7 @@
 #include <tcob/core/Size.hpp>
 #include <tcob/core/Stopwatch.hpp>
 #include <tcob/core/StringUtils.hpp>
+#include <tcob/core/Task.hpp>
 #include <tcob/core/TaskManager.hpp>
 #include <tcob/core/Timer.hpp>
 #include <tcob/core/TypeFactory.hpp>
@@ -65,6 +68,7 @@
 #include <tcob/data/ConfigFile.hpp>
 #include <tcob/data/ConfigSchema.hpp>
 #include <tcob/data/ConfigTypes.hpp>
+#include <tcob/data/Json.hpp>
 #include <tcob/data/Sqlite.hpp>
 #include <tcob/data/SqliteColumn.hpp>
 #include <tcob/data/SqliteConversions.hpp>
@@ -74,6 +78,7 @@
 #include <tcob/data/SqliteStatement.hpp>
 #include <tcob/data/SqliteTable.hpp>
 
+#include <tcob/gfx/AABBTree.hpp>
 #include <tcob/gfx/Camera.hpp>
 #include <tcob/gfx/Canvas.hpp>
 #include <tcob/gfx/ColorGradient.hpp>
@@ -88,6 +93,7 @@
 #include <tcob/gfx/Polygon.hpp>
 #include <tcob/gfx/Quadtree.hpp>
 #include <tcob/gfx/Ray.hpp>
+#include <tcob/gfx/RenderQueue.hpp>
 #include <tcob/gfx/RenderSystem.hpp>
 #include <tcob/gfx/RenderSystemImpl.hpp>
 #include <tcob/gfx/RenderTarget.hpp>
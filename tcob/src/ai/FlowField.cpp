@@ -0,0 +1,88 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "tcob/ai/FlowField.hpp"
+
+#include <algorithm>
+
+#include "tcob/core/Point.hpp"
+#include "tcob/core/ServiceLocator.hpp"
+#include "tcob/core/Size.hpp"
+#include "tcob/core/TaskManager.hpp"
+
+namespace tcob::ai {
+
+flow_field::flow_field(bool allowDiagonal)
+    : _allowDiagonal {allowDiagonal}
+{
+}
+
+auto flow_field::target() const -> point_i
+{
+    return _target;
+}
+
+auto flow_field::extent() const -> size_i
+{
+    return _integration.size();
+}
+
+auto flow_field::is_reachable(point_i pos) const -> bool
+{
+    return _integration[pos] != astar_pathfinding::IMPASSABLE_COST;
+}
+
+auto flow_field::get_cost(point_i pos) const -> u64
+{
+    return _integration[pos];
+}
+
+auto flow_field::get_direction(point_i pos) const -> point_i
+{
+    return Directions[_directions[pos]];
+}
+
+void flow_field::build_fields(pathfinding_context const& ctx)
+{
+    size_i const extent {ctx._extent};
+    if (_integration.size() != extent) {
+        _integration = grid<u64> {extent};
+        _directions  = grid<u8> {extent};
+    }
+
+    // the parent of each settled cell is its next step towards the target
+    locate_service<task_manager>().run_parallel(
+        [&](par_task const& task) {
+            for (isize idx {task.Start}; idx < task.End; ++idx) {
+                i32 const cell {static_cast<i32>(idx)};
+                if (!ctx.is_closed(cell) || cell == ctx.index_of(_target)) {
+                    _integration[idx] = ctx.is_closed(cell) ? 0 : astar_pathfinding::IMPASSABLE_COST;
+                    _directions[idx]  = 0;
+                    continue;
+                }
+
+                _integration[idx] = ctx.get_score(cell);
+
+                point_i const step {ctx.position_of(ctx._parent[static_cast<usize>(idx)]) - ctx.position_of(cell)};
+                _directions[idx] = static_cast<u8>(std::ranges::find(Directions, step) - Directions.begin());
+            }
+        },
+        static_cast<isize>(extent.Width) * extent.Height, 4096);
+}
+
+////////////////////////////////////////////////////////////
+
+flow_field_cache::flow_field_cache(usize capacity, bool allowDiagonal)
+    : _capacity {std::max<usize>(capacity, 1)}
+    , _allowDiagonal {allowDiagonal}
+{
+}
+
+void flow_field_cache::clear()
+{
+    _entries.clear();
+}
+
+}
@@ -6,18 +6,149 @@
 #include "tcob/ai/Pathfinding.hpp"
 
 #include <algorithm>
-#include <array>
-#include <unordered_map>
+#include <cmath>
+#include <limits>
 #include <vector>
 
 #include "tcob/core/Point.hpp"
+#include "tcob/core/Rect.hpp"
 #include "tcob/core/Size.hpp"
 
 namespace tcob::ai {
 
-astar_pathfinding::astar_pathfinding(bool allowDiagonal, heuristic heuristic)
+void pathfinding_context::reserve(size_i gridExtent)
+{
+    usize const count {static_cast<usize>(gridExtent.Width) * static_cast<usize>(gridExtent.Height)};
+    if (_gScore.size() >= count) { return; }
+
+    _gScore.resize(count);
+    _parent.resize(count);
+    _openStamp.resize(count, 0);
+    _closedStamp.resize(count, 0);
+}
+
+void pathfinding_context::prepare(size_i gridExtent)
+{
+    reserve(gridExtent);
+    _extent = gridExtent;
+    _heap.clear();
+
+    // stamps from older queries are stale, so nothing has to be cleared per query
+    if (++_generation == 0) {
+        std::ranges::fill(_openStamp, 0);
+        std::ranges::fill(_closedStamp, 0);
+        _generation = 1;
+    }
+}
+
+auto pathfinding_context::index_of(point_i pos) const -> i32
+{
+    return (pos.Y * _extent.Width) + pos.X;
+}
+
+auto pathfinding_context::position_of(i32 idx) const -> point_i
+{
+    return {idx % _extent.Width, idx / _extent.Width};
+}
+
+auto pathfinding_context::is_open(i32 idx) const -> bool
+{
+    return _openStamp[static_cast<usize>(idx)] == _generation;
+}
+
+auto pathfinding_context::is_closed(i32 idx) const -> bool
+{
+    return _closedStamp[static_cast<usize>(idx)] == _generation;
+}
+
+auto pathfinding_context::get_score(i32 idx) const -> u64
+{
+    return is_open(idx) ? _gScore[static_cast<usize>(idx)] : std::numeric_limits<u64>::max();
+}
+
+void pathfinding_context::open(i32 idx, u64 gScore, i32 parent)
+{
+    auto const i {static_cast<usize>(idx)};
+    _gScore[i]      = gScore;
+    _parent[i]      = parent;
+    _openStamp[i]   = _generation;
+    _closedStamp[i] = 0; // reopen if a better path was found
+}
+
+void pathfinding_context::close(i32 idx)
+{
+    _closedStamp[static_cast<usize>(idx)] = _generation;
+}
+
+auto pathfinding_context::heap_empty() const -> bool
+{
+    return _heap.empty();
+}
+
+void pathfinding_context::heap_push(heap_node node)
+{
+    _heap.push_back(node);
+
+    usize i {_heap.size() - 1};
+    while (i > 0) {
+        usize const parent {(i - 1) / 4};
+        if (_heap[parent].Score <= node.Score) { break; }
+        _heap[i] = _heap[parent];
+        i        = parent;
+    }
+    _heap[i] = node;
+}
+
+auto pathfinding_context::heap_pop() -> heap_node
+{
+    heap_node const retValue {_heap.front()};
+    heap_node const last {_heap.back()};
+    _heap.pop_back();
+
+    usize const n {_heap.size()};
+    if (n == 0) { return retValue; }
+
+    usize i {0};
+    for (;;) {
+        usize const first {(i * 4) + 1};
+        if (first >= n) { break; }
+
+        usize       best {first};
+        usize const end {std::min(first + 4, n)};
+        for (usize c {first + 1}; c < end; ++c) {
+            if (_heap[c].Score < _heap[best].Score) { best = c; }
+        }
+        if (_heap[best].Score >= last.Score) { break; }
+
+        _heap[i] = _heap[best];
+        i        = best;
+    }
+    _heap[i] = last;
+
+    return retValue;
+}
+
+auto pathfinding_context::reconstruct_path(i32 start, i32 finish) const -> std::vector<point_i>
+{
+    std::vector<point_i> retValue;
+    for (i32 idx {finish}; idx != start; idx = _parent[static_cast<usize>(idx)]) {
+        point_i       pos {position_of(idx)};
+        point_i const parent {position_of(_parent[static_cast<usize>(idx)])};
+        point_i const step {std::clamp(parent.X - pos.X, -1, 1), std::clamp(parent.Y - pos.Y, -1, 1)};
+
+        // jump points are not adjacent, fill in the cells in between
+        for (; pos != parent; pos += step) { retValue.push_back(pos); }
+    }
+    std::ranges::reverse(retValue);
+    return retValue;
+}
+
+////////////////////////////////////////////////////////////
+
+astar_pathfinding::astar_pathfinding(bool allowDiagonal, heuristic heuristic, search search)
     : _allowDiagonal {allowDiagonal}
     , _heuristic {heuristic}
+    , _search {search}
 {
 }
 
@@ -32,56 +163,109 @@ auto astar_pathfinding::distance(point_i a, point_i b) const -> u64
     return 0;
 }
 
-auto astar_pathfinding::neighbors(size_i gridSize, point_i pos) const -> std::vector<point_i>
+auto astar_pathfinding::octile_distance(point_i a, point_i b) -> u64
 {
-    static constexpr std::array<point_i, 4> orthogonalDirections {{
-        {0, 1},  // Down
-        {1, 0},  // Right
-        {0, -1}, // Up
-        {-1, 0}, // Left
-    }};
+    u64 const dx {static_cast<u64>(std::abs(a.X - b.X))};
+    u64 const dy {static_cast<u64>(std::abs(a.Y - b.Y))};
+    return (StraightCost * std::max(dx, dy)) + ((DiagonalCost - StraightCost) * std::min(dx, dy));
+}
 
-    static constexpr std::array<point_i, 4> diagonalDirections {{
-        {1, 1},   // RightDown
-        {-1, -1}, // LeftUp
-        {1, -1},  // RightUp
-        {-1, 1},  // LeftDown
-    }};
+////////////////////////////////////////////////////////////
 
-    std::vector<point_i> retValue;
+hpa_pathfinding::hpa_pathfinding(i32 clusterSize, bool allowDiagonal)
+    : _clusterSize {std::max(clusterSize, 2)}
+    , _allowDiagonal {allowDiagonal}
+    , _local {allowDiagonal, allowDiagonal ? astar_pathfinding::heuristic::Chebyshev : astar_pathfinding::heuristic::Manhattan}
+{
+}
 
-    for (auto const& dir : orthogonalDirections) {
-        point_i const neighbor {pos.X + dir.X, pos.Y + dir.Y};
-        if (neighbor.X >= 0 && neighbor.X < gridSize.Width && neighbor.Y >= 0 && neighbor.Y < gridSize.Height) {
-            retValue.push_back(neighbor);
-        }
-    }
+void hpa_pathfinding::invalidate(rect_i const& area)
+{
+    if (_clusters.empty()) { return; }
 
-    if (_allowDiagonal) {
-        for (auto const& dir : diagonalDirections) {
-            point_i const neighbor {pos.X + dir.X, pos.Y + dir.Y};
-            if (neighbor.X >= 0 && neighbor.X < gridSize.Width && neighbor.Y >= 0 && neighbor.Y < gridSize.Height) {
-                retValue.push_back(neighbor);
-            }
+    rect_i const clamped {area.as_intersection_with({point_i::Zero, _extent})};
+    if (clamped.width() <= 0 || clamped.height() <= 0) { return; }
+
+    i32 const left {clamped.left() / _clusterSize};
+    i32 const top {clamped.top() / _clusterSize};
+    i32 const right {(clamped.right() - 1) / _clusterSize};
+    i32 const bottom {(clamped.bottom() - 1) / _clusterSize};
+    for (i32 y {top}; y <= bottom; ++y) {
+        for (i32 x {left}; x <= right; ++x) {
+            _clusters[static_cast<usize>((y * _clusterCount.Width) + x)].Dirty = true;
         }
     }
 
+    _isDirty = true;
+}
+
+auto hpa_pathfinding::node_count() const -> usize
+{
+    return _nodes.size() - _freeNodes.size();
+}
+
+auto hpa_pathfinding::edge_count() const -> usize
+{
+    usize retValue {0};
+    for (auto const& n : _nodes) {
+        if (n.Cluster < 0) { continue; }
+        retValue += n.Edges.size() + 1;
+    }
     return retValue;
 }
 
-auto astar_pathfinding::reconstruct_path(std::unordered_map<point_i, point_i> const& cameFrom, point_i current) const -> std::vector<point_i>
+auto hpa_pathfinding::cluster_of(point_i pos) const -> i32
 {
-    std::vector<point_i> retValue;
-    while (cameFrom.contains(current)) {
-        retValue.push_back(current);
-        current = cameFrom.at(current);
+    return ((pos.Y / _clusterSize) * _clusterCount.Width) + (pos.X / _clusterSize);
+}
+
+auto hpa_pathfinding::neighbor_cluster(i32 clusterIdx, usize border) const -> i32
+{
+    if (border == 0) { // right
+        return (clusterIdx % _clusterCount.Width) < _clusterCount.Width - 1 ? clusterIdx + 1 : -1;
     }
-    std::ranges::reverse(retValue);
+    // bottom
+    return (clusterIdx / _clusterCount.Width) < _clusterCount.Height - 1 ? clusterIdx + _clusterCount.Width : -1;
+}
+
+auto hpa_pathfinding::add_node(point_i pos, i32 clusterIdx) -> i32
+{
+    i32 retValue {};
+    if (_freeNodes.empty()) {
+        retValue = static_cast<i32>(_nodes.size());
+        _nodes.emplace_back();
+    } else {
+        retValue = _freeNodes.back();
+        _freeNodes.pop_back();
+    }
+
+    auto& n {_nodes[static_cast<usize>(retValue)]};
+    n.Position = pos;
+    n.Cluster  = clusterIdx;
+    n.Partner  = -1;
+    n.Edges.clear();
+
+    _clusters[static_cast<usize>(clusterIdx)].Nodes.push_back(retValue);
     return retValue;
 }
 
-auto astar_pathfinding::node::operator>(node const& other) const -> bool
+void hpa_pathfinding::clear_border(i32 clusterIdx, usize border)
 {
-    return score > other.score;
+    auto& nodes {_clusters[static_cast<usize>(clusterIdx)].Borders[border]};
+    for (i32 const id : nodes) {
+        auto& n {_nodes[static_cast<usize>(id)]};
+        std::erase(_clusters[static_cast<usize>(n.Cluster)].Nodes, id);
+        n.Cluster = -1;
+        n.Partner = -1;
+        n.Edges.clear();
+        _freeNodes.push_back(id);
+    }
+    nodes.clear();
 }
+
+auto hpa_pathfinding::distance(point_i a, point_i b) const -> u64
+{
+    return static_cast<u64>(_allowDiagonal ? chebyshev_distance(a, b) : manhattan_distance(a, b));
+}
+
 }
@@ -71,7 +71,7 @@ platform::platform(bool headless, game::init const& ginit)
     logger::Info("starting");
 
     InitSignatures();
-    InitTaskManager(ginit.WorkerThreads);
+    InitTaskManager(ginit.WorkerThreads, ginit.Scheduling);
     InitConfigFormats();
     InitImageCodecs();
     InitAudioCodecs();
@@ -139,7 +139,8 @@ auto platform::HeadlessInit(path const& logFile) -> std::shared_ptr<platform>
                            .LogFile        = logFile,
                            .ConfigFile     = "",
                            .ConfigDefaults = {},
-                           .WorkerThreads  = std::nullopt}}};
+                           .WorkerThreads  = std::nullopt,
+                           .Scheduling     = task_scheduling::Shared}}};
 }
 
 auto platform::config() const -> data::config_file&
@@ -304,12 +305,13 @@ void platform::InitFontEngines()
     gfx::truetype_font_engine::Init();
 }
 
-void platform::InitTaskManager(std::optional<isize> workerThreads)
+void platform::InitTaskManager(std::optional<isize> workerThreads, task_scheduling scheduling)
 {
     register_service<task_manager>(std::make_shared<task_manager>(
         workerThreads
             ? *workerThreads
-            : static_cast<isize>(std::thread::hardware_concurrency())));
+            : static_cast<isize>(std::thread::hardware_concurrency()),
+        scheduling));
 }
 
 ////////////////////////////////////////////////////////////
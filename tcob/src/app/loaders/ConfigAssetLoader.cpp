@@ -767,11 +767,13 @@ void cfg_texture_loader::prepare()
         }
 
         // load images
+        set_asset_status(def->assetPtr, asset_status::Loading);
+
+        def->pendingImages = def->images.size();
+        _pendingImages += def->images.size();
         for (auto& img : def->images) {
-            img.Future = img.Image.load_async(img.Path);
+            _loadTasks.push_back(load_image(*def, img));
         }
-
-        set_asset_status(def->assetPtr, asset_status::Loading);
     }
 
     for (auto const& def : _cacheAni) {
@@ -786,69 +788,48 @@ void cfg_texture_loader::prepare()
     }
     _cacheAni.clear();
 
-    locate_service<task_manager>().run_deferred([this](def_task const& ctx) { check_async_load(ctx); });
+    if (_pendingImages == 0) { finish_loading(); }
 }
 
-void cfg_texture_loader::check_async_load(def_task const& ctx)
+auto cfg_texture_loader::load_image(tex_asset_def& def, image_def& img) -> task<>
 {
-    if (_cacheTex.empty()) {
-        ctx.Finished = true;
-        return;
-    }
+    auto& tm {locate_service<task_manager>()};
 
-    // check if async images have been loaded and update textures
-    bool loadingDone {true};
-    for (auto it {_cacheTex.begin()}; it != _cacheTex.end(); ++it) {
-        auto const& def {*it};
-        if (def->assetPtr.get()->status() == asset_status::Loaded) { continue; }
-
-        auto& images {def->images};
-
-        bool assetLoadingDone {true};
-        for (auto imgIt {images.begin()}; imgIt != images.end(); ++imgIt) {
-            if (auto& statusFuture {imgIt->Future}; statusFuture.valid()) {
-                // not ready -> continue
-                if (statusFuture.wait_for(0s) != std::future_status::ready) {
-                    assetLoadingDone = false;
-                    continue;
-                }
+    // decode on a worker thread...
+    co_await tm.resume_on_worker();
+    bool const loaded {img.Image.load(img.Path)};
 
-                // loading error -> log and continue
-                if (!statusFuture.get()) {
-                    logger::Error("texture asset '{}': Error loading image {}.", def->assetPtr.get()->name(), imgIt->Path);
-                    set_asset_status(def->assetPtr, asset_status::Error);
-                    continue;
-                }
+    // ...and upload on the main thread
+    co_await tm.resume_on_main();
+    auto const& tex {*def.assetPtr};
+    auto const& imgInfo {img.Image.info()};
 
-                // update texture
-                auto const& tex {*def->assetPtr};
-                auto const& img {imgIt->Image};
-                auto const& imgInfo {img.info()};
+    if (!loaded || tex.info().Size != imgInfo.Size) {
+        logger::Error("texture asset '{}': Error loading image {}.", def.assetPtr.get()->name(), img.Path);
+        set_asset_status(def.assetPtr, asset_status::Error);
+    } else {
+        tex.update_data(img.Image.data(), img.Depth, 0, imgInfo.bytes_per_pixel() == 4 ? 4 : 1);
+    }
+    img.Image = {};
 
-                if (tex.info().Size != imgInfo.Size) {
-                    logger::Error("texture asset '{}': Error loading image {}.", def->assetPtr.get()->name(), imgIt->Path);
-                    set_asset_status(def->assetPtr, asset_status::Error);
-                    continue;
-                }
+    if (--def.pendingImages == 0 && def.assetPtr.get()->status() != asset_status::Error) {
+        set_asset_status(def.assetPtr, asset_status::Loaded);
+    }
 
-                tex.update_data(img.data(), imgIt->Depth, 0, imgInfo.bytes_per_pixel() == 4 ? 4 : 1);
-                imgIt->Image = {};
-            }
-        }
+    // last image: release all loading state, this task must not touch def or img afterwards
+    if (--_pendingImages == 0) { finish_loading(); }
+}
 
-        if (assetLoadingDone) {
-            if (def->assetPtr.get()->status() != asset_status::Error) {
-                set_asset_status(def->assetPtr, asset_status::Loaded);
-            }
-        } else {
-            loadingDone = false;
+void cfg_texture_loader::finish_loading()
+{
+    for (auto const& def : _cacheTex) {
+        auto const status {def->assetPtr.get()->status()};
+        if (status != asset_status::Error && status != asset_status::Loaded) {
+            set_asset_status(def->assetPtr, asset_status::Loaded);
         }
     }
 
-    if (loadingDone) {
-        _cacheTex.clear();
-    }
-
-    ctx.Finished = _cacheTex.empty();
+    _cacheTex.clear();
+    _loadTasks.clear();
 }
 }
@@ -19,6 +19,7 @@
 #include "tcob/audio/Sound.hpp"
 #include "tcob/audio/synth/SoundFont.hpp"
 #include "tcob/core/Size.hpp"
+#include "tcob/core/Task.hpp"
 #include "tcob/core/TaskManager.hpp"
 #include "tcob/data/ConfigTypes.hpp"
 #include "tcob/gfx/Font.hpp"
@@ -228,14 +229,11 @@ public:
     void prepare() override;
 
 private:
-    void check_async_load(def_task const& ctx);
-
     // texture
-    struct image_ftr {
-        u32               Depth {};
-        path              Path {};
-        gfx::image        Image {};
-        std::future<bool> Future {};
+    struct image_def {
+        u32        Depth {};
+        path       Path {};
+        gfx::image Image {};
     };
 
     struct tex_asset_def {
@@ -245,10 +243,16 @@ private:
         size_i                                          size {size_i::Zero};
         std::unordered_map<string, gfx::texture_region> abs_regions;
 
-        std::vector<image_ftr> images;
+        std::vector<image_def> images;
+        usize                  pendingImages {0};
     };
 
+    auto load_image(tex_asset_def& def, image_def& img) -> task<>;
+    void finish_loading();
+
     std::vector<std::unique_ptr<tex_asset_def>> _cacheTex;
+    std::vector<task<>>                         _loadTasks;
+    usize                                       _pendingImages {0};
 
     // animated texture
     struct ani_asset_def {
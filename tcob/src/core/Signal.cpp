@@ -7,8 +7,6 @@
 
 #include <utility>
 
-#include "tcob/core/random/Random.hpp"
-
 namespace tcob {
 
 namespace detail {
@@ -19,13 +17,6 @@ namespace detail {
         _connections.clear();
     }
 
-    ////////////////////////////////////////////////////////////
-
-    auto signal_base::next_id() const -> uid
-    {
-        return get_random_ID();
-    }
-
 }
 
 ////////////////////////////////////////////////////////////
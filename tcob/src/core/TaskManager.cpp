@@ -8,59 +8,423 @@
 #include <algorithm>
 #include <atomic>
 #include <cassert>
+#include <chrono>
+#include <format>
+#include <latch>
 #include <mutex>
 #include <stop_token>
 #include <thread>
 #include <utility>
 
 #include "tcob/core/Common.hpp"
-#include "tcob/core/random/Random.hpp"
+#include "tcob/core/Logger.hpp"
+#include "tcob/core/random/Engine.hpp"
 
 namespace tcob {
 
-task_manager::task_manager(isize threads)
+namespace detail {
+    ////////////////////////////////////////////////////////////
+
+    // Chase-Lev deque: the owning worker pushes and pops at the bottom, thieves steal from the top.
+    class work_stealing_queue final {
+    public:
+        using task_ptr = std::function<void()>*;
+
+        work_stealing_queue()
+        {
+            _rings.push_back(std::make_unique<ring>(INITIAL_CAPACITY));
+            _ring.store(_rings.back().get(), std::memory_order_relaxed);
+        }
+
+        ~work_stealing_queue()
+        {
+            while (task_ptr task {pop()}) { delete task; }
+        }
+
+        void push(task_ptr task)
+        {
+            i64 const b {_bottom.load(std::memory_order_relaxed)};
+            i64 const t {_top.load(std::memory_order_acquire)};
+            ring*     r {_ring.load(std::memory_order_relaxed)};
+
+            if (b - t > r->Capacity - 1) { r = grow(r, b, t); }
+
+            r->put(b, task);
+            _bottom.store(b + 1, std::memory_order_release);
+        }
+
+        auto pop() -> task_ptr
+        {
+            i64 const b {_bottom.load(std::memory_order_relaxed) - 1};
+            ring*     r {_ring.load(std::memory_order_relaxed)};
+            _bottom.store(b, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 t {_top.load(std::memory_order_relaxed)};
+
+            if (t > b) {
+                _bottom.store(b + 1, std::memory_order_relaxed);
+                return nullptr;
+            }
+
+            task_ptr task {r->get(b)};
+            if (t == b) {
+                // last element: race against thieves
+                if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    task = nullptr;
+                }
+                _bottom.store(b + 1, std::memory_order_relaxed);
+            }
+            return task;
+        }
+
+        auto steal() -> task_ptr
+        {
+            i64 t {_top.load(std::memory_order_acquire)};
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            i64 const b {_bottom.load(std::memory_order_acquire)};
+
+            if (t >= b) { return nullptr; }
+
+            ring*          r {_ring.load(std::memory_order_acquire)};
+            task_ptr const task {r->get(t)};
+            if (!_top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return task;
+        }
+
+    private:
+        static constexpr i64 INITIAL_CAPACITY {256};
+
+        struct ring {
+            explicit ring(i64 capacity)
+                : Capacity {capacity}
+                , Mask {capacity - 1}
+                , Slots {std::make_unique<std::atomic<task_ptr>[]>(static_cast<usize>(capacity))}
+            {
+            }
+
+            auto get(i64 i) const -> task_ptr { return Slots[static_cast<usize>(i & Mask)].load(std::memory_order_relaxed); }
+            void put(i64 i, task_ptr task) { Slots[static_cast<usize>(i & Mask)].store(task, std::memory_order_relaxed); }
+
+            i64                                      Capacity;
+            i64                                      Mask;
+            std::unique_ptr<std::atomic<task_ptr>[]> Slots;
+        };
+
+        auto grow(ring* r, i64 b, i64 t) -> ring*
+        {
+            auto  newRing {std::make_unique<ring>(r->Capacity * 2)};
+            ring* retValue {newRing.get()};
+            for (i64 i {t}; i < b; ++i) { retValue->put(i, r->get(i)); }
+
+            // old rings stay alive until destruction, thieves may still read from them
+            _rings.push_back(std::move(newRing));
+            _ring.store(retValue, std::memory_order_release);
+            return retValue;
+        }
+
+        alignas(64) std::atomic<i64> _top {0};
+        alignas(64) std::atomic<i64> _bottom {0};
+
+        std::atomic<ring*>                 _ring {nullptr};
+        std::vector<std::unique_ptr<ring>> _rings;
+    };
+}
+
+////////////////////////////////////////////////////////////
+
+auto task_graph::add_node(string const& name, node_func const& func) -> usize
+{
+    _nodes.push_back({.Name = name, .Func = func});
+    _isChanged = true;
+    return _nodes.size() - 1;
+}
+
+void task_graph::add_dependency(usize node, usize dependsOn)
+{
+    assert(node < _nodes.size() && dependsOn < _nodes.size());
+    _nodes[dependsOn].Successors.push_back(node);
+    ++_nodes[node].Dependencies;
+    _isChanged = true;
+}
+
+void task_graph::clear()
+{
+    _nodes.clear();
+    _isChanged = true;
+}
+
+auto task_graph::node_count() const -> usize
+{
+    return _nodes.size();
+}
+
+auto task_graph::is_acyclic() const -> bool
+{
+    // Kahn's algorithm: every node must be reachable through a topological order
+    std::vector<isize> dependencies(_nodes.size());
+    std::vector<usize> ready;
+    for (usize i {0}; i < _nodes.size(); ++i) {
+        dependencies[i] = _nodes[i].Dependencies;
+        if (dependencies[i] == 0) { ready.push_back(i); }
+    }
+
+    usize visited {0};
+    while (!ready.empty()) {
+        usize const node {ready.back()};
+        ready.pop_back();
+        ++visited;
+        for (usize const succ : _nodes[node].Successors) {
+            if (--dependencies[succ] == 0) { ready.push_back(succ); }
+        }
+    }
+
+    return visited == _nodes.size();
+}
+
+auto task_graph::trace_json() const -> string
+{
+    auto const escape {[](string const& str) {
+        string retValue;
+        retValue.reserve(str.size());
+        for (char const c : str) {
+            if (c == '"' || c == '\\') { retValue += '\\'; }
+            retValue += c;
+        }
+        return retValue;
+    }};
+
+    string retValue {"{\"traceEvents\":["};
+    for (usize i {0}; i < _nodes.size(); ++i) {
+        auto const& node {_nodes[i]};
+        if (i > 0) { retValue += ','; }
+        retValue += std::format(R"({{"name":"{}","ph":"X","ts":{:.3f},"dur":{:.3f},"pid":0,"tid":{}}})",
+                                escape(node.Name), node.Start, node.Duration, node.Thread);
+    }
+    retValue += "]}";
+    return retValue;
+}
+
+////////////////////////////////////////////////////////////
+
+static thread_local task_manager const* tlsOwner {nullptr};
+static thread_local isize               tlsWorkerIndex {-1};
+
+task_manager::task_manager(isize threads, task_scheduling scheduling)
     : _threadCount {threads}
+    , _scheduling {scheduling}
     , _mainThreadID {std::this_thread::get_id()}
 {
-    for (isize i {0}; i < _threadCount; ++i) {
-        _taskWorkers.emplace_back([this](std::stop_token const& stopToken) { worker_thread(stopToken); });
+    if (_scheduling == task_scheduling::WorkStealing) {
+        for (isize i {0}; i < _threadCount; ++i) {
+            _localQueues.push_back(std::make_unique<detail::work_stealing_queue>());
+        }
+        for (isize i {0}; i < _threadCount; ++i) {
+            _taskWorkers.emplace_back([this, i](std::stop_token const& stopToken) { work_stealing_thread(stopToken, i); });
+        }
+    } else {
+        for (isize i {0}; i < _threadCount; ++i) {
+            _taskWorkers.emplace_back([this, i](std::stop_token const& stopToken) { worker_thread(stopToken, i); });
+        }
     }
 }
 
 task_manager::~task_manager()
 {
+    // queued tasks and deferred callbacks that are still pending are dropped without running;
+    // the game drains the deferred queue on shutdown while the services are still alive
     for (auto& worker : _taskWorkers) { worker.request_stop(); }
-    _taskCondition.notify_all();
+    {
+        std::scoped_lock lock {_taskMutex};
+        _taskCondition.notify_all();
+    }
     for (auto& worker : _taskWorkers) { worker.join(); }
 }
 
 void task_manager::run_parallel(par_func const& func, isize count, isize minRange)
 {
+    if (count <= 0) { return; }
+    minRange = std::max<isize>(1, minRange);
+
     isize const numThreads {std::min(_threadCount, count / minRange)};
 
     if (numThreads <= 1) {
         par_task const ctx {.Start = 0, .End = count, .Thread = 0};
         func(ctx);
+        return;
+    }
+
+    // the calling thread participates as thread 0; all participants claim
+    // guided chunks (large first, shrinking towards minRange) from a shared cursor.
+    // Helpers that are dequeued after the cursor ran out only touch the shared state,
+    // so the call completes as soon as every claimed chunk has finished.
+    auto const run {std::make_shared<parallel_run>(func, count, minRange, numThreads)};
+
+    for (isize i {1}; i < numThreads; ++i) {
+        add_task([run, i] { run_parallel_chunks(*run, i); });
+    }
+
+    run_parallel_chunks(*run, 0);
+
+    isize const worker {current_worker()};
+    if (worker == -1) {
+        isize done {run->Done.load(std::memory_order_acquire)};
+        while (done != count) {
+            run->Done.wait(done, std::memory_order_acquire);
+            done = run->Done.load(std::memory_order_acquire);
+        }
     } else {
-        isize const        partitionSize {count / numThreads};
-        std::atomic<isize> activeTasks {numThreads};
+        // a waiting worker keeps executing tasks, otherwise nested calls could starve the pool
+        while (run->Done.load(std::memory_order_acquire) != count) {
+            if (!try_run_task(worker)) { std::this_thread::yield(); }
+        }
+    }
+}
+
+void task_manager::run_parallel_chunks(parallel_run& run, isize thread)
+{
+    for (;;) {
+        isize start {run.Cursor.load(std::memory_order_relaxed)};
+        isize end {0};
+        do {
+            isize const remaining {run.Count - start};
+            if (remaining <= 0) { return; }
+            end = start + std::min(remaining, std::max(run.MinRange, remaining / (run.Threads * 2)));
+        } while (!run.Cursor.compare_exchange_weak(start, end, std::memory_order_relaxed));
+
+        // the caller waits for every claimed chunk, so Func is still alive here
+        (*run.Func)({.Start = start, .End = end, .Thread = thread});
 
-        for (isize i {0}; i < numThreads; ++i) {
-            isize const start {i * partitionSize};
-            isize const end {(i == numThreads - 1) ? count : start + partitionSize};
-            add_task([func, ctx = par_task {.Start = start, .End = end, .Thread = i}, &activeTasks] {
-                func(ctx);
-                --activeTasks;
-            });
+        if (run.Done.fetch_add(end - start, std::memory_order_acq_rel) + (end - start) == run.Count) {
+            run.Done.notify_all();
         }
+    }
+}
 
-        while (activeTasks > 0) { std::this_thread::yield(); }
+void task_manager::run_detached(std::function<void()> func)
+{
+    if (_threadCount > 0) {
+        add_task(std::move(func));
+    } else {
+        func();
+    }
+}
+
+auto task_manager::run_graph(task_graph& graph) -> bool
+{
+    if (graph._nodes.empty()) { return true; }
+
+    // validate and collect the roots only when the graph has changed since the last run
+    if (graph._isChanged) {
+        graph._isAcyclic = graph.is_acyclic();
+        graph._roots.clear();
+        for (usize i {0}; i < graph._nodes.size(); ++i) {
+            if (graph._nodes[i].Dependencies == 0) { graph._roots.push_back(i); }
+        }
+        graph._isChanged = false;
+    }
+    if (!graph._isAcyclic) {
+        logger::Error("task_graph: dependency cycle detected");
+        return false;
+    }
+
+    usize const nodeCount {graph._nodes.size()};
+    if (graph._pendingSize != nodeCount) {
+        graph._pending     = std::make_unique<std::atomic<isize>[]>(nodeCount);
+        graph._pendingSize = nodeCount;
+    }
+    for (usize i {0}; i < nodeCount; ++i) {
+        graph._pending[i].store(graph._nodes[i].Dependencies, std::memory_order_relaxed);
+    }
+
+    auto const& roots {graph._roots};
+    auto const  run {std::make_shared<graph_run>(static_cast<isize>(nodeCount))};
+    for (usize i {1}; i < roots.size(); ++i) { push_ready_node(graph, roots[i], run); }
+    run_graph_node(graph, roots[0], run);
+
+    // the calling thread only helps with this graph's nodes, never with unrelated pool tasks
+    while (!run->Done.try_wait()) {
+        usize const node {pop_ready_node(*run)};
+        if (node != task_graph::INVALID_NODE) {
+            run_graph_node(graph, node, run);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    if (run->Exception) { std::rethrow_exception(run->Exception); }
+    return true;
+}
+
+void task_manager::push_ready_node(task_graph& graph, usize node, std::shared_ptr<graph_run> const& run)
+{
+    {
+        std::scoped_lock lock {run->ReadyMutex};
+        run->Ready.push_back(node);
+    }
+
+    // the pool task takes whichever node is ready when it starts; it finds none
+    // if the caller got there first, and then must not touch the graph anymore
+    if (_threadCount > 0) {
+        add_task([this, &graph, run] {
+            usize const next {pop_ready_node(*run)};
+            if (next != task_graph::INVALID_NODE) { run_graph_node(graph, next, run); }
+        });
+    }
+}
+
+auto task_manager::pop_ready_node(graph_run& run) -> usize
+{
+    std::scoped_lock lock {run.ReadyMutex};
+    if (run.Ready.empty()) { return task_graph::INVALID_NODE; }
+
+    usize const retValue {run.Ready.back()};
+    run.Ready.pop_back();
+    return retValue;
+}
+
+void task_manager::run_graph_node(task_graph& graph, usize node, std::shared_ptr<graph_run> const& run)
+{
+    isize const thread {current_worker() + 1};
+
+    while (node != task_graph::INVALID_NODE) {
+        auto& n {graph._nodes[node]};
+
+        // after a failure the remaining nodes are skipped, but still counted down
+        auto const nodeStart {clock::now()};
+        if (n.Func && !run->Failed.load(std::memory_order_acquire)) {
+            try {
+                n.Func();
+            } catch (...) {
+                if (!run->Failed.exchange(true, std::memory_order_acq_rel)) { run->Exception = std::current_exception(); }
+            }
+        }
+        auto const nodeEnd {clock::now()};
+
+        n.Start    = std::chrono::duration<f64, std::micro> {nodeStart - run->Start}.count();
+        n.Duration = std::chrono::duration<f64, std::micro> {nodeEnd - nodeStart}.count();
+        n.Thread   = thread;
+
+        // the first ready successor continues on this thread, the others are enqueued
+        usize next {task_graph::INVALID_NODE};
+        for (usize const succ : n.Successors) {
+            if (graph._pending[succ].fetch_sub(1, std::memory_order_acq_rel) != 1) { continue; }
+            if (next == task_graph::INVALID_NODE) {
+                next = succ;
+            } else {
+                push_ready_node(graph, succ, run);
+            }
+        }
+
+        run->Done.count_down();
+        node = next;
     }
 }
 
 auto task_manager::run_deferred(def_func const& func) -> uid
 {
-    uid const id {get_random_ID()};
+    uid const id {_nextDeferredID.fetch_add(1, std::memory_order_relaxed)};
 
     std::scoped_lock lock {_deferredMutex};
     _deferredQueueFront.emplace_back(func, id);
@@ -77,26 +441,98 @@ void task_manager::drop_deferred(uid id)
     helper::erase_first(_deferredQueueBack, [id](auto const& ctx) { return ctx.second == id; });
 }
 
+auto task_manager::resume_on_worker() -> worker_awaitable
+{
+    return {.Manager = this};
+}
+
+auto task_manager::resume_on_main() -> main_awaitable
+{
+    return {.Manager = this};
+}
+
+auto task_manager::resume_after(milliseconds delay) -> delay_awaitable
+{
+    return {.Manager = this, .Delay = delay};
+}
+
 auto task_manager::thread_count() const -> isize
 {
     return _threadCount;
 }
 
+auto task_manager::scheduling() const -> task_scheduling
+{
+    return _scheduling;
+}
+
 void task_manager::add_task(task_func&& func)
 {
-    {
+    if (_scheduling == task_scheduling::Shared) {
+        {
+            std::scoped_lock lock {_taskMutex};
+            _taskQueue.emplace(std::move(func));
+        }
+        _taskCondition.notify_one();
+        return;
+    }
+
+    isize const worker {current_worker()};
+    if (worker != -1) {
+        // spawned from a worker: push to its own deque without locking
+        _localQueues[static_cast<usize>(worker)]->push(new task_func {std::move(func)});
+    } else {
         std::scoped_lock lock {_taskMutex};
         _taskQueue.emplace(std::move(func));
     }
-    _taskCondition.notify_one();
+
+    _pendingTasks.fetch_add(1, std::memory_order_seq_cst);
+    if (_sleepingWorkers.load(std::memory_order_seq_cst) > 0) {
+        std::scoped_lock lock {_taskMutex};
+        _taskCondition.notify_one();
+    }
+}
+
+auto task_manager::worker_awaitable::await_ready() const noexcept -> bool
+{
+    return Manager->_threadCount == 0;
+}
+
+void task_manager::worker_awaitable::await_suspend(std::coroutine_handle<> handle) const
+{
+    Manager->add_task([handle] { handle.resume(); });
+}
+
+void task_manager::main_awaitable::await_suspend(std::coroutine_handle<> handle) const
+{
+    Manager->run_deferred([handle](def_task const&) { handle.resume(); });
+}
+
+void task_manager::delay_awaitable::await_suspend(std::coroutine_handle<> handle) const
+{
+    Manager->run_deferred([handle, remaining = Delay](def_task const& ctx) mutable {
+        remaining -= ctx.DeltaTime;
+        if (remaining > milliseconds::zero() && !ctx.AbortRequested) {
+            ctx.Finished = false;
+            return;
+        }
+
+        handle.resume();
+    });
+}
+
+auto task_manager::current_worker() const -> isize
+{
+    return tlsOwner == this ? tlsWorkerIndex : -1;
 }
 
 auto task_manager::process_queue(milliseconds deltaTime, bool abort) -> bool
 {
     assert(std::this_thread::get_id() == _mainThreadID);
-    if (_deferredQueueFront.empty()) { return true; }
 
     std::scoped_lock lock {_deferredMutex};
+    if (_deferredQueueFront.empty()) { return true; }
+
     std::swap(_deferredQueueFront, _deferredQueueBack);
 
     for (auto& task : _deferredQueueBack) {
@@ -111,8 +547,11 @@ auto task_manager::process_queue(milliseconds deltaTime, bool abort) -> bool
     return false;
 }
 
-void task_manager::worker_thread(std::stop_token const& stopToken)
+void task_manager::worker_thread(std::stop_token const& stopToken, isize index)
 {
+    tlsOwner       = this;
+    tlsWorkerIndex = index;
+
     while (!stopToken.stop_requested()) {
         task_func task;
 
@@ -129,4 +568,84 @@ void task_manager::worker_thread(std::stop_token const& stopToken)
         task();
     }
 }
+
+void task_manager::work_stealing_thread(std::stop_token const& stopToken, isize index)
+{
+    tlsOwner       = this;
+    tlsWorkerIndex = index;
+
+    while (!stopToken.stop_requested()) {
+        if (try_run_task(index)) { continue; }
+
+        std::unique_lock lock {_taskMutex};
+        _sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+        _taskCondition.wait(lock, stopToken, [this] { return _pendingTasks.load(std::memory_order_seq_cst) > 0; });
+        _sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+    }
+}
+
+auto task_manager::try_run_task(isize index) -> bool
+{
+    if (_scheduling == task_scheduling::Shared) {
+        task_func task;
+        {
+            std::scoped_lock lock {_taskMutex};
+            if (_taskQueue.empty()) { return false; }
+            task = std::move(_taskQueue.front());
+            _taskQueue.pop();
+        }
+
+        task();
+        return true;
+    }
+
+    // 1. own deque
+    if (index != -1) {
+        if (auto* task {_localQueues[static_cast<usize>(index)]->pop()}) {
+            _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+            (*task)();
+            delete task;
+            return true;
+        }
+    }
+
+    // 2. external submissions
+    {
+        task_func task;
+        {
+            std::unique_lock lock {_taskMutex, std::try_to_lock};
+            if (lock.owns_lock() && !_taskQueue.empty()) {
+                task = std::move(_taskQueue.front());
+                _taskQueue.pop();
+            }
+        }
+        if (task) {
+            _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+            task();
+            return true;
+        }
+    }
+
+    // 3. steal from random victims
+    usize const count {_localQueues.size()};
+    if (count == 0) { return false; }
+
+    static thread_local random::xorshift_64::state_type rngState {static_cast<u64>(index + 2) * 0x9E3779B97F4A7C15ULL};
+    random::xorshift_64 const                           rng {};
+
+    usize const start {static_cast<usize>(rng(rngState) % count)};
+    for (usize i {0}; i < count; ++i) {
+        usize const victim {(start + i) % count};
+        if (victim == static_cast<usize>(index)) { continue; }
+        if (auto* task {_localQueues[victim]->steal()}) {
+            _pendingTasks.fetch_sub(1, std::memory_order_relaxed);
+            (*task)();
+            delete task;
+            return true;
+        }
+    }
+
+    return false;
+}
+
 }
@@ -6,10 +6,12 @@
 #include "tcob/data/ConfigTypes.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <cstddef>
 #include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string_view>
 #include <tuple>
 #include <utility>
 
@@ -27,6 +29,79 @@ namespace tcob::data {
 
 ////////////////////////////////////////////////////////////
 
+void cfg_object_entries::clear()
+{
+    _entries.clear();
+    _index.clear();
+}
+
+void cfg_object_entries::emplace_back(string_view key, entry const& ent)
+{
+    _entries.emplace_back(key, ent);
+
+    if (!_index.empty()) {
+        insert_index(_entries.size() - 1);
+    } else if (_entries.size() >= IndexThreshold) {
+        rebuild_index();
+    }
+}
+
+void cfg_object_entries::erase(string_view key)
+{
+    auto const index {find_index(key)};
+    if (index == _entries.size()) { return; }
+
+    _entries.erase(_entries.begin() + static_cast<isize>(index));
+    rebuild_index();
+}
+
+auto cfg_object_entries::find_index(string_view key) const -> usize
+{
+    if (_index.empty()) {
+        for (usize i {0}; i < _entries.size(); ++i) {
+            if (_entries[i].first == key) { return i; }
+        }
+        return _entries.size();
+    }
+
+    usize const mask {_index.size() - 1};
+    for (usize slot {std::hash<string_view> {}(key) & mask};; slot = (slot + 1) & mask) {
+        u32 const value {_index[slot]};
+        if (value == 0) { return _entries.size(); }
+        if (_entries[value - 1].first == key) { return value - 1; }
+    }
+}
+
+void cfg_object_entries::insert_index(usize index)
+{
+    // keep the load factor at or below 0.5
+    if ((_entries.size() * 2) > _index.size()) {
+        rebuild_index();
+        return;
+    }
+
+    usize const mask {_index.size() - 1};
+    usize       slot {std::hash<string_view> {}(_entries[index].first) & mask};
+    while (_index[slot] != 0) { slot = (slot + 1) & mask; }
+    _index[slot] = static_cast<u32>(index + 1);
+}
+
+void cfg_object_entries::rebuild_index()
+{
+    _index.clear();
+    if (_entries.size() < IndexThreshold) { return; }
+
+    _index.resize(std::bit_ceil(_entries.size() * 4));
+    usize const mask {_index.size() - 1};
+    for (usize i {0}; i < _entries.size(); ++i) {
+        usize slot {std::hash<string_view> {}(_entries[i].first) & mask};
+        while (_index[slot] != 0) { slot = (slot + 1) & mask; }
+        _index[slot] = static_cast<u32>(i + 1);
+    }
+}
+
+////////////////////////////////////////////////////////////
+
 object::object() noexcept
     : object {std::make_shared<cfg_object_entries>()}
 {
@@ -183,17 +258,17 @@ void object::add_entry(string_view key, entry const& entry)
 
 void object::remove_entry(string_view key)
 {
-    values()->erase(find(key));
+    values()->erase(key);
 }
 
 auto object::find(string_view key) -> cfg_object_entries::iterator
 {
-    return std::ranges::find_if(*this, [&key](auto const& p) { return p.first == key; });
+    return values()->find(key);
 }
 
 auto object::find(string_view key) const -> cfg_object_entries::const_iterator
 {
-    return std::ranges::find_if(*this, [&key](auto const& p) { return p.first == key; });
+    return std::as_const(*values()).find(key);
 }
 
 ////////////////////////////////////////////////////////////
@@ -9,6 +9,7 @@
 
     #include <cassert>
     #include <format>
+    #include <memory>
 
     #include <sqlite3/sqlite3.h>
 
@@ -81,6 +82,18 @@ auto statement_view::bind(i32 idx, f64 value) const -> bool
     return sqlite3_bind_double(_stmt, idx, value) == SQLITE_OK;
 }
 
+auto statement_view::reset() const -> bool
+{
+    assert(_stmt);
+    return sqlite3_reset(_stmt) == SQLITE_OK;
+}
+
+auto statement_view::clear_bindings() const -> bool
+{
+    assert(_stmt);
+    return sqlite3_clear_bindings(_stmt) == SQLITE_OK;
+}
+
 void statement_view::finalize()
 {
     if (_stmt) {
@@ -152,6 +165,68 @@ auto statement_view::bind_null(i32 idx) -> bool
 
 ////////////////////////////////////////////////////////////
 
+statement_cache::statement_cache(usize capacity)
+    : _capacity {capacity}
+{
+}
+
+statement_cache::~statement_cache()
+{
+    close();
+}
+
+auto statement_cache::size() const -> usize
+{
+    return _entries.size();
+}
+
+auto statement_cache::acquire(utf8_string const& sql) -> statement_view
+{
+    auto it {_lookup.find(sql)};
+    if (it == _lookup.end()) { return statement_view {nullptr}; }
+
+    // the statement is handed out exclusively until it is released again
+    statement_view const retValue {it->second->second};
+    _entries.erase(it->second);
+    _lookup.erase(it);
+    return retValue;
+}
+
+void statement_cache::release(utf8_string const& sql, statement_view stmt)
+{
+    if (!stmt) { return; }
+
+    if (_capacity == 0 || _lookup.contains(sql)) {
+        stmt.finalize();
+        return;
+    }
+
+    stmt.reset();
+    stmt.clear_bindings();
+
+    _entries.emplace_front(sql, stmt);
+    _lookup[sql] = _entries.begin();
+
+    if (_entries.size() > _capacity) {
+        auto& [lruSql, lruStmt] {_entries.back()};
+        lruStmt.finalize();
+        _lookup.erase(lruSql);
+        _entries.pop_back();
+    }
+}
+
+void statement_cache::close()
+{
+    for (auto& [_, stmt] : _entries) {
+        stmt.finalize();
+    }
+    _entries.clear();
+    _lookup.clear();
+    _capacity = 0;
+}
+
+////////////////////////////////////////////////////////////
+
 database_view::database_view(sqlite3* db)
     : _db {db}
 {
@@ -165,11 +240,13 @@ database_view::operator bool() const
 auto database_view::open(path const& file) -> bool
 {
     [[maybe_unused]] static auto reg {detail::register_vfs()};
-    return sqlite3_open_v2(file.c_str(), &_db, SQLITE_OPEN_READWRITE, reg.c_str()) == SQLITE_OK;
+    return sqlite3_open_v2(file.c_str(), &_db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, reg.c_str()) == SQLITE_OK;
 }
 
 auto database_view::close() -> bool
 {
+    if (_cache) { _cache->close(); }
+
     if (_db) {
         auto err {sqlite3_close(_db)};
         _db = nullptr;
@@ -188,6 +265,31 @@ auto database_view::prepare(utf8_string_view sql) const -> statement_view
     return statement_view {stmt};
 }
 
+auto database_view::with_statement_cache(usize capacity) const -> database_view
+{
+    database_view retValue {_db};
+    if (_db) { retValue._cache = std::make_shared<statement_cache>(capacity); }
+    return retValue;
+}
+
+auto database_view::acquire_statement(utf8_string const& sql) const -> statement_view
+{
+    if (_cache) {
+        if (auto stmt {_cache->acquire(sql)}) { return stmt; }
+    }
+
+    return prepare(sql);
+}
+
+void database_view::release_statement(utf8_string const& sql, statement_view stmt) const
+{
+    if (_cache) {
+        _cache->release(sql, stmt);
+    } else {
+        stmt.finalize();
+    }
+}
+
 auto database_view::exec(utf8_string const& sql) const -> bool
 {
     assert(_db);
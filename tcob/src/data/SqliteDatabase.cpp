@@ -56,8 +56,8 @@ database::database()
 }
 
 database::database(database_view db)
-    : _db {db}
-    , _main {db, "main"}
+    : _db {db.with_statement_cache()}
+    , _main {_db, "main"}
 {
 }
 
@@ -27,12 +27,13 @@ statement::statement(database_view db)
 
 statement::~statement()
 {
-    _stmt.finalize();
+    _db.release_statement(_sql, _stmt);
 }
 
 statement::statement(statement&& other) noexcept
     : _db {std::exchange(other._db, database_view {nullptr})}
     , _stmt {std::exchange(other._stmt, statement_view {nullptr})}
+    , _sql {std::move(other._sql)}
 {
 }
 
@@ -40,17 +41,24 @@ auto statement::operator=(statement&& other) noexcept -> statement&
 {
     std::swap(_db, other._db);
     std::swap(_stmt, other._stmt);
+    std::swap(_sql, other._sql);
     return *this;
 }
 
 auto statement::prepare(utf8_string const& sql) -> bool
 {
-    _stmt.finalize();
-    _stmt = _db.prepare(sql);
+    // same query as before: rewind instead of preparing again
+    if (is_valid() && sql == _sql) { return reset(); }
+
+    _db.release_statement(_sql, _stmt);
+    _stmt = _db.acquire_statement(sql);
     if (!is_valid()) {
+        _sql.clear();
         logger::Error("SQLite: {}", _db.error_message());
         return false;
     }
+
+    _sql = sql;
     return true;
 }
 
@@ -63,6 +71,14 @@ auto statement::step() const -> step_status
     return retValue;
 }
 
+auto statement::reset() const -> bool
+{
+    if (!is_valid()) { return false; }
+
+    _stmt.reset();
+    return _stmt.clear_bindings();
+}
+
 auto statement::get_column_name(i32 col) const -> utf8_string
 {
     return _stmt.get_column_name(col);
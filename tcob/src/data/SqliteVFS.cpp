@@ -7,8 +7,15 @@
 
 #if defined(TCOB_ENABLE_ADDON_DATA_SQLITE)
 
+    #include <algorithm>
     #include <cassert>
     #include <cstring>
+    #include <map>
+    #include <mutex>
+    #include <optional>
+    #include <unordered_map>
+    #include <utility>
+    #include <vector>
 
     #include <sqlite3/sqlite3.h>
 
@@ -20,84 +27,427 @@ namespace tcob::db::detail {
 
 namespace fs = tcob::io;
 
-extern "C" {
-struct physfs_sqlite3_file {
-    sqlite3_file SqliteFile;
-    char const*  FileName;
+////////////////////////////////////////////////////////////
+
+// One open PhysFS file per sqlite3_file.
+// PhysFS can't open a file for reading and writing at the same time, so a
+// read handle is kept for the whole lifetime and a write handle is opened on
+// the first write. Both handles are unbuffered and therefore see each other's
+// data.
+// With caching enabled, reads and writes go through an in-memory page cache
+// and dirty pages are written back on sync or close. Files without a name
+// (temporary files) live entirely in memory.
+// PhysFS has no file locks, so locking only tracks the level. Dirty pages are
+// written back when the shared lock is released, clean pages are kept. The
+// file is only written through this VFS, so every physical write bumps a
+// per-file generation, and the cache is dropped on the next shared lock if
+// another connection has written since.
+class write_generations final {
+public:
+    static auto get(string const& name) -> u64
+    {
+        std::scoped_lock lock {Mutex};
+        auto const       it {Generations.find(name)};
+        return it != Generations.end() ? it->second : 0;
+    }
+
+    static auto increment(string const& name) -> u64
+    {
+        std::scoped_lock lock {Mutex};
+        return ++Generations[name];
+    }
+
+private:
+    static inline std::mutex                      Mutex;
+    static inline std::unordered_map<string, u64> Generations;
+};
+
+class physfs_file final {
+public:
+    static constexpr i64   PageSize {4096};
+    static constexpr usize MaxPages {1024};
+
+    physfs_file(char const* name, bool readOnly, bool cached, bool deleteOnClose);
+    ~physfs_file();
+
+    auto is_valid() const -> bool;
+
+    auto read(byte* dst, i64 amount, i64 offset) -> int;
+    auto write(byte const* src, i64 amount, i64 offset) -> int;
+    auto truncate(i64 size) -> int;
+    auto sync() -> int;
+    auto size() const -> i64;
+
+    auto lock(int level) -> int;
+    auto unlock(int level) -> int;
+
+private:
+    struct page {
+        std::vector<byte> Data;
+        bool              Dirty {false};
+    };
+
+    auto is_memory_only() const -> bool;
+
+    auto get_page(i64 index) -> page&;
+    void mark_dirty(page& page);
+    auto trim_pages() -> bool;
+    auto write_back() -> bool;
+
+    auto read_physical(byte* dst, i64 amount, i64 offset) const -> i64;
+    auto write_physical(byte const* src, i64 amount, i64 offset) -> bool;
+    auto truncate_physical(i64 size) -> bool;
+
+    auto open_writer() -> bool;
+
+    string                       _name;
+    bool                         _readOnly;
+    bool                         _cached;
+    bool                         _deleteOnClose;
+    std::optional<fs::file_sink> _reader;
+    std::optional<fs::file_sink> _writer;
+    i64                          _size {0};         //!< logical size, including cached writes
+    i64                          _physicalSize {0}; //!< size of the file on disk
+    std::map<i64, page>          _pages;
+    usize                        _dirtyPages {0};
+    int                          _lockLevel {SQLITE_LOCK_NONE};
+    u64                          _generation {0}; //!< write generation the cached pages belong to
 };
 
-static auto xClose(sqlite3_file* /* f */) -> int
+physfs_file::physfs_file(char const* name, bool readOnly, bool cached, bool deleteOnClose)
+    : _name {name ? name : ""}
+    , _readOnly {readOnly}
+    , _cached {cached || !name}
+    , _deleteOnClose {deleteOnClose}
 {
-    return SQLITE_OK;
+    if (is_memory_only()) { return; }
+
+    _generation = write_generations::get(_name);
+    _reader.emplace(fs::file_sink::OpenRead(_name));
+    if (_reader->is_valid()) {
+        _physicalSize = _reader->size_in_bytes();
+        _size         = _physicalSize;
+    }
 }
 
-static auto xRead(sqlite3_file* f, void* dst, int iAmt, sqlite3_int64 iOfst) -> int
+physfs_file::~physfs_file()
 {
-    auto const* file {reinterpret_cast<physfs_sqlite3_file const*>(f)};
-    assert(&file->SqliteFile == f);
+    if (is_memory_only()) { return; }
 
-    if (!fs::is_file(file->FileName)) { return SQLITE_IOERR; }
+    if (!_deleteOnClose) { sync(); }
+    _reader.reset();
+    _writer.reset();
 
-    fs::ifstream stream {file->FileName};
+    if (_deleteOnClose && fs::delete_file(_name)) { write_generations::increment(_name); }
+}
 
-    if (!stream.seek(iOfst, io::seek_dir::Begin)) { return SQLITE_IOERR_READ; }
+auto physfs_file::is_valid() const -> bool
+{
+    return is_memory_only() || (_reader && _reader->is_valid());
+}
+
+auto physfs_file::is_memory_only() const -> bool
+{
+    return _name.empty();
+}
 
-    auto* dstBuffer {static_cast<byte*>(dst)};
-    auto  nRead {stream.read_to<byte>({dstBuffer, static_cast<usize>(iAmt)})};
+auto physfs_file::read(byte* dst, i64 amount, i64 offset) -> int
+{
+    i64 nRead {0};
+
+    if (_cached) {
+        if (!trim_pages()) { return SQLITE_IOERR_READ; }
+
+        i64 const end {std::min(offset + amount, _size)};
+        for (i64 pos {offset}; pos < end;) {
+            i64 const pageOffset {pos % PageSize};
+            i64 const count {std::min(PageSize - pageOffset, end - pos)};
+            auto&     page {get_page(pos / PageSize)};
+            std::memcpy(dst + (pos - offset), page.Data.data() + pageOffset, static_cast<usize>(count));
+            pos += count;
+        }
+        nRead = std::max<i64>(0, end - offset);
+    } else {
+        nRead = read_physical(dst, std::min(amount, std::max<i64>(0, _size - offset)), offset);
+        if (nRead < 0) { return SQLITE_IOERR_READ; }
+    }
+
+    if (nRead < amount) {
+        std::memset(dst + nRead, 0, static_cast<usize>(amount - nRead));
+        return SQLITE_IOERR_SHORT_READ;
+    }
 
-    if (nRead < 0) { return SQLITE_IOERR_READ; }
-    if (nRead < iAmt) { std::memset(dstBuffer + nRead, 0, iAmt - nRead); }
     return SQLITE_OK;
 }
 
-static auto xWrite(sqlite3_file* f, void const* src, int iAmt, sqlite3_int64 iOfst) -> int
+auto physfs_file::write(byte const* src, i64 amount, i64 offset) -> int
 {
-    auto const* file {reinterpret_cast<physfs_sqlite3_file const*>(f)};
-    assert(&file->SqliteFile == f);
+    if (_readOnly) { return SQLITE_READONLY; }
+
+    if (_cached) {
+        if (!trim_pages()) { return SQLITE_IOERR_WRITE; }
+
+        i64 const end {offset + amount};
+        for (i64 pos {offset}; pos < end;) {
+            i64 const pageOffset {pos % PageSize};
+            i64 const count {std::min(PageSize - pageOffset, end - pos)};
+            auto&     page {get_page(pos / PageSize)};
+            std::memcpy(page.Data.data() + pageOffset, src + (pos - offset), static_cast<usize>(count));
+            mark_dirty(page);
+            pos += count;
+        }
+    } else if (!write_physical(src, amount, offset)) {
+        return SQLITE_IOERR_WRITE;
+    }
+
+    _size = std::max(_size, offset + amount);
+    return SQLITE_OK;
+}
 
-    if (!fs::is_file(file->FileName)) { return SQLITE_IOERR; }
+auto physfs_file::truncate(i64 size) -> int
+{
+    if (_readOnly) { return SQLITE_READONLY; }
+
+    if (_cached) {
+        // drop whole pages past the new end and clear the tail of the last one
+        i64 const lastPage {(size + PageSize - 1) / PageSize};
+        auto const first {_pages.lower_bound(lastPage)};
+        _dirtyPages -= static_cast<usize>(std::count_if(first, _pages.end(), [](auto const& entry) { return entry.second.Dirty; }));
+        _pages.erase(first, _pages.end());
+        if (size % PageSize != 0) {
+            if (auto it {_pages.find(size / PageSize)}; it != _pages.end()) {
+                auto& data {it->second.Data};
+                std::fill(data.begin() + (size % PageSize), data.end(), byte {0});
+                mark_dirty(it->second);
+            }
+        }
+    } else if (size != _physicalSize && !truncate_physical(size)) {
+        return SQLITE_IOERR_TRUNCATE;
+    }
 
-    fs::ofstream stream {file->FileName, 4096, true};
+    _size = size;
+    return SQLITE_OK;
+}
 
-    if (!stream.seek(iOfst, io::seek_dir::Begin)) { return SQLITE_IOERR_SEEK; }
+auto physfs_file::sync() -> int
+{
+    if (_readOnly || is_memory_only()) { return SQLITE_OK; }
 
-    auto const* srcBuffer {static_cast<byte const*>(src)};
-    auto const  written {stream.write<byte>({srcBuffer, static_cast<usize>(iAmt)})};
+    if (_cached) {
+        if (_physicalSize > _size && !truncate_physical(_size)) { return SQLITE_IOERR_FSYNC; }
+        if (!write_back()) { return SQLITE_IOERR_FSYNC; }
+    }
 
-    return written == iAmt ? SQLITE_OK : SQLITE_IOERR_WRITE;
+    if (_writer && !_writer->flush()) { return SQLITE_IOERR_FSYNC; }
+    return SQLITE_OK;
 }
 
-static auto xTruncate(sqlite3_file* /* f */, sqlite3_int64 /* size */) -> int
+auto physfs_file::size() const -> i64
 {
-    return SQLITE_OK;
+    return _size;
 }
 
-static auto xSync(sqlite3_file* /* f */, int /* flags */) -> int
+auto physfs_file::lock(int level) -> int
 {
+    bool const acquire {_lockLevel == SQLITE_LOCK_NONE && level > SQLITE_LOCK_NONE};
+    _lockLevel = std::max(_lockLevel, level);
+
+    if (!acquire || !_cached || is_memory_only()) { return SQLITE_OK; }
+
+    // another connection has written the file since the cache was filled
+    u64 const generation {write_generations::get(_name)};
+    if (generation == _generation) { return SQLITE_OK; }
+
+    _generation = generation;
+    _pages.clear();
+    _dirtyPages = 0;
+    _physicalSize = _reader && _reader->is_valid() ? _reader->size_in_bytes() : 0;
+    _size         = _physicalSize;
     return SQLITE_OK;
 }
 
-static auto xFileSize(sqlite3_file* f, sqlite3_int64* pSize) -> int
+auto physfs_file::unlock(int level) -> int
+{
+    if (level >= _lockLevel) { return SQLITE_OK; }
+    _lockLevel = level;
+
+    if (level != SQLITE_LOCK_NONE || !_cached || is_memory_only()) { return SQLITE_OK; }
+
+    // clean pages stay cached for the next transaction
+    return sync() == SQLITE_OK ? SQLITE_OK : SQLITE_IOERR_UNLOCK;
+}
+
+auto physfs_file::get_page(i64 index) -> page&
+{
+    auto [it, inserted] {_pages.try_emplace(index)};
+    auto& page {it->second};
+    if (inserted) {
+        page.Data.resize(static_cast<usize>(PageSize));
+        // only bytes that are both on disk and inside the logical size are valid
+        i64 const base {index * PageSize};
+        i64 const avail {std::clamp<i64>(std::min(_size, _physicalSize) - base, 0, PageSize)};
+        i64 const nRead {avail > 0 ? read_physical(page.Data.data(), avail, base) : 0};
+        if (nRead < PageSize) {
+            std::fill(page.Data.begin() + std::max<i64>(nRead, 0), page.Data.end(), byte {0});
+        }
+    }
+    return page;
+}
+
+void physfs_file::mark_dirty(page& page)
+{
+    if (page.Dirty) { return; }
+
+    page.Dirty = true;
+    ++_dirtyPages;
+}
+
+auto physfs_file::trim_pages() -> bool
+{
+    if (is_memory_only() || _pages.size() < MaxPages) { return true; }
+
+    // clean pages can simply be dropped, dirty ones have to be written back first
+    std::erase_if(_pages, [](auto const& entry) { return !entry.second.Dirty; });
+    if (_pages.size() < MaxPages / 2) { return true; }
+
+    if (!write_back()) { return false; }
+    _pages.clear();
+    return true;
+}
+
+auto physfs_file::write_back() -> bool
+{
+    if (is_memory_only() || _dirtyPages == 0) { return true; }
+
+    // pages are ordered by index, so this writes the file front to back
+    for (auto& [index, page] : _pages) {
+        if (!page.Dirty) { continue; }
+
+        i64 const base {index * PageSize};
+        i64 const count {std::min(PageSize, _size - base)};
+        if (count > 0 && !write_physical(page.Data.data(), count, base)) { return false; }
+        page.Dirty = false;
+        --_dirtyPages;
+    }
+
+    return true;
+}
+
+auto physfs_file::read_physical(byte* dst, i64 amount, i64 offset) const -> i64
+{
+    if (amount <= 0) { return 0; }
+    if (!_reader || !_reader->seek(offset, io::seek_dir::Begin)) { return -1; }
+    return _reader->read_bytes(dst, amount);
+}
+
+auto physfs_file::write_physical(byte const* src, i64 amount, i64 offset) -> bool
+{
+    if (!open_writer()) { return false; }
+    if (!_writer->seek(offset, io::seek_dir::Begin)) { return false; }
+    if (_writer->write_bytes(src, amount) != amount) { return false; }
+
+    _physicalSize = std::max(_physicalSize, offset + amount);
+    _generation   = write_generations::increment(_name);
+    return true;
+}
+
+auto physfs_file::truncate_physical(i64 size) -> bool
 {
-    auto const* file {reinterpret_cast<physfs_sqlite3_file const*>(f)};
+    // PhysFS has no truncate, so the file is rewritten with its first 'size' bytes
+    std::vector<byte> buffer(static_cast<usize>(size));
+    i64 const         keep {std::min(size, _physicalSize)};
+    if (keep > 0 && read_physical(buffer.data(), keep, 0) != keep) { return false; }
+
+    _reader.reset();
+    _writer.reset();
+
+    auto writer {fs::file_sink::OpenWrite(_name)};
+    if (!writer.is_valid()) { return false; }
+    if (size > 0 && writer.write_bytes(buffer.data(), size) != size) { return false; }
+    if (!writer.close()) { return false; }
+
+    _physicalSize = size;
+    _generation   = write_generations::increment(_name);
+    _reader.emplace(fs::file_sink::OpenRead(_name));
+    if (_reader->is_valid()) { return true; }
+
+    _reader.reset();
+    return false;
+}
+
+auto physfs_file::open_writer() -> bool
+{
+    if (_writer) { return true; }
+    if (_readOnly || is_memory_only()) { return false; }
+
+    auto writer {fs::file_sink::OpenAppend(_name)};
+    if (!writer.is_valid()) { return false; }
+
+    _writer.emplace(std::move(writer));
+    return true;
+}
+
+////////////////////////////////////////////////////////////
+
+extern "C" {
+struct physfs_sqlite3_file {
+    sqlite3_file SqliteFile;
+    physfs_file* File;
+};
+
+static auto get_file(sqlite3_file* f) -> physfs_file*
+{
+    auto* file {reinterpret_cast<physfs_sqlite3_file*>(f)};
     assert(&file->SqliteFile == f);
+    return file->File;
+}
 
-    if (!fs::is_file(file->FileName)) { return SQLITE_IOERR; }
+static auto xClose(sqlite3_file* f) -> int
+{
+    auto* file {reinterpret_cast<physfs_sqlite3_file*>(f)};
+    assert(&file->SqliteFile == f);
 
-    *pSize = fs::get_file_size(file->FileName);
+    delete file->File;
+    file->File = nullptr;
     return SQLITE_OK;
 }
 
-static auto xLock(sqlite3_file* /* f */, int /* level */) -> int
+static auto xRead(sqlite3_file* f, void* dst, int iAmt, sqlite3_int64 iOfst) -> int
 {
-    return SQLITE_OK;
+    return get_file(f)->read(static_cast<byte*>(dst), iAmt, iOfst);
+}
+
+static auto xWrite(sqlite3_file* f, void const* src, int iAmt, sqlite3_int64 iOfst) -> int
+{
+    return get_file(f)->write(static_cast<byte const*>(src), iAmt, iOfst);
+}
+
+static auto xTruncate(sqlite3_file* f, sqlite3_int64 size) -> int
+{
+    return get_file(f)->truncate(size);
 }
 
-static auto xUnlock(sqlite3_file* /* f */, int /* level */) -> int
+static auto xSync(sqlite3_file* f, int /* flags */) -> int
 {
+    return get_file(f)->sync();
+}
+
+static auto xFileSize(sqlite3_file* f, sqlite3_int64* pSize) -> int
+{
+    *pSize = get_file(f)->size();
     return SQLITE_OK;
 }
 
+static auto xLock(sqlite3_file* f, int level) -> int
+{
+    return get_file(f)->lock(level);
+}
+
+static auto xUnlock(sqlite3_file* f, int level) -> int
+{
+    return get_file(f)->unlock(level);
+}
+
 static auto xCheckReservedLock(sqlite3_file* /* f */, int* pResOut) -> int
 {
     *pResOut = false;
@@ -146,19 +496,35 @@ static auto xOpen(sqlite3_vfs*, char const* zName, sqlite3_file* f, int flags, i
     auto* file {reinterpret_cast<physfs_sqlite3_file*>(f)};
     assert(&file->SqliteFile == f);
 
-    file->SqliteFile.pMethods = &physfs_sqlite3_io_methods;
-    file->FileName            = zName;
+    file->SqliteFile.pMethods = nullptr;
+    file->File                = nullptr;
 
-    bool const exists {fs::is_file(zName)};
+    if (zName) {
+        bool const exists {fs::is_file(zName)};
 
-    if ((flags & SQLITE_OPEN_CREATE) && !exists) {
-        if (!fs::create_file(zName)) {
-            return SQLITE_IOERR;
+        if ((flags & SQLITE_OPEN_CREATE) && !exists) {
+            if (!fs::create_file(zName)) {
+                return SQLITE_IOERR;
+            }
+        } else if (!exists) {
+            return SQLITE_CANTOPEN;
         }
-    } else if (!exists) {
+    }
+
+    // page cache can be disabled per database with the 'physfs_cache=0' URI parameter
+    bool const cached {zName == nullptr || sqlite3_uri_boolean(zName, "physfs_cache", 1) != 0};
+    bool const readOnly {(flags & SQLITE_OPEN_READONLY) != 0};
+    bool const deleteOnClose {(flags & SQLITE_OPEN_DELETEONCLOSE) != 0};
+
+    auto* handle {new physfs_file {zName, readOnly, cached, deleteOnClose}};
+    if (!handle->is_valid()) {
+        delete handle;
         return SQLITE_CANTOPEN;
     }
 
+    file->SqliteFile.pMethods = &physfs_sqlite3_io_methods;
+    file->File                = handle;
+
     if (pOutFlags) { *pOutFlags = flags; }
 
     return SQLITE_OK;
@@ -166,7 +532,10 @@ static auto xOpen(sqlite3_vfs*, char const* zName, sqlite3_file* f, int flags, i
 
 static auto xDelete(sqlite3_vfs*, char const* zName, int /* syncDir */) -> int
 {
-    return fs::delete_file(zName) ? SQLITE_OK : SQLITE_IOERR_DELETE;
+    if (!fs::delete_file(zName)) { return SQLITE_IOERR_DELETE; }
+
+    write_generations::increment(zName);
+    return SQLITE_OK;
 }
 
 static auto xAccess(sqlite3_vfs*, char const* zName, int flags, int* pResOut) -> int
@@ -5,183 +5,417 @@
 
 #include "Config_json.hpp"
 
+#include <cstring>
+#include <format>
 #include <optional>
 #include <string>
 #include <variant>
+#include <vector>
 
 #include "tcob/core/StringUtils.hpp"
 #include "tcob/core/io/Stream.hpp"
 #include "tcob/data/ConfigConversions.hpp"
 #include "tcob/data/ConfigTypes.hpp"
+#include "tcob/data/Json.hpp"
 
 namespace tcob::data::detail {
 
-static auto find_unquoted(string_view source, char needle) -> string_view::size_type
+constexpr usize INDENT_SPACES {2};
+constexpr usize MAX_DEPTH {1000};
+
+////////////////////////////////////////////////////////////
+
+// Finds the next '"' or '\\', testing eight bytes per step.
+static auto find_string_special(char const* first, char const* last) -> char const*
 {
-    char const quote {source[0]};
-    if (quote != '"' && quote != '\'') {
-        return source.find(needle);
+    constexpr u64 ones {0x0101010101010101};
+    constexpr u64 highs {0x8080808080808080};
+    constexpr u64 quotes {ones * '"'};
+    constexpr u64 backslashes {ones * '\\'};
+
+    while (last - first >= 8) {
+        u64 word {0};
+        std::memcpy(&word, first, 8);
+        u64 const q {word ^ quotes};
+        u64 const b {word ^ backslashes};
+        if ((((q - ones) & ~q) | ((b - ones) & ~b)) & highs) { break; }
+        first += 8;
+    }
+
+    while (first != last && *first != '"' && *first != '\\') { ++first; }
+    return first;
+}
+
+static void append_utf8(utf8_string& str, u32 cp)
+{
+    if (cp < 0x80) {
+        str += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        str += static_cast<char>(0xC0 | (cp >> 6));
+        str += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        str += static_cast<char>(0xE0 | (cp >> 12));
+        str += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        str += static_cast<char>(0xF0 | (cp >> 18));
+        str += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        str += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        str += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+////////////////////////////////////////////////////////////
+
+template <typename Handler>
+class json_parser {
+public:
+    json_parser(utf8_string_view txt, Handler& handler)
+        : _txt {txt}
+        , _handler {handler}
+    {
+    }
+
+    // expected is '{', '[' or 0 for any value
+    auto parse(char expected) -> bool
+    {
+        skip_whitespace();
+        if (expected != 0 && peek() != expected) { return false; }
+        if (!parse_value(MAX_DEPTH)) { return false; }
+        skip_whitespace();
+        return _pos == _txt.size();
     }
 
-    bool  inQuotes {false};
-    usize pos {0};
-    for (auto const c : source) {
-        if (c == quote) {
-            inQuotes = !inQuotes;
-        } else if (!inQuotes && c == needle) {
-            return pos;
+private:
+    auto peek() const -> char
+    {
+        return _pos < _txt.size() ? _txt[_pos] : '\0';
+    }
+
+    void skip_whitespace()
+    {
+        while (_pos < _txt.size()) {
+            char const c {_txt[_pos]};
+            if (c != ' ' && c != '\n' && c != '\r' && c != '\t') { break; }
+            ++_pos;
         }
-        ++pos;
     }
 
-    return string_view::npos;
-}
+    auto parse_value(usize maxDepth) -> bool
+    {
+        switch (peek()) {
+        case '{': return parse_object(maxDepth);
+        case '[': return parse_array(maxDepth);
+        case '"': {
+            utf8_string_view str;
+            return parse_string(str) && _handler.on_string(str);
+        }
+        case 't': return parse_literal("true") && _handler.on_bool(true);
+        case 'f': return parse_literal("false") && _handler.on_bool(false);
+        case 'n': return parse_literal("null") && _handler.on_null();
+        default:  return parse_number();
+        }
+    }
 
-constexpr usize INDENT_SPACES {2};
+    auto parse_object(usize maxDepth) -> bool
+    {
+        if (maxDepth == 0) { return false; }
 
-auto json_reader::read_as_object(utf8_string_view txt) -> std::optional<object>
-{
-    entry currentEntry;
-    return ReadObject(currentEntry, helper::trim(txt)) ? std::optional<object> {currentEntry.as<object>()} : std::nullopt;
-}
+        ++_pos; // '{'
+        if (!_handler.on_object_begin()) { return false; }
 
-auto json_reader::read_as_array(utf8_string_view txt) -> std::optional<array>
-{
-    entry currentEntry;
-    return ReadArray(currentEntry, helper::trim(txt)) ? std::optional<array> {currentEntry.as<array>()} : std::nullopt;
-}
+        skip_whitespace();
+        if (peek() == '}') {
+            ++_pos;
+            return _handler.on_object_end();
+        }
 
-auto json_reader::ReadKeyValuePair(object& obj, entry& currentEntry, utf8_string_view line) -> bool
-{
-    if (line.empty()) { return false; }
+        for (;;) {
+            skip_whitespace();
+            if (peek() != '"') { return false; } // ERROR: invalid key
 
-    auto const separatorPos {find_unquoted(line, ':')};
-    if (separatorPos == utf8_string::npos) { return false; } // ERROR: invalid pair
+            utf8_string_view key;
+            if (!parse_string(key) || key.empty()) { return false; } // ERROR: empty key
+            if (!_handler.on_key(key)) { return false; }
 
-    auto const keyStr {helper::trim(line.substr(0, separatorPos))};
-    auto const valueStr {helper::trim(line.substr(separatorPos + 1))};
+            skip_whitespace();
+            if (peek() != ':') { return false; } // ERROR: invalid pair
+            ++_pos;
 
-    if (keyStr.size() <= 1 || valueStr.empty()) { return false; }                 //  ERROR: empty key or value
-    if (keyStr[0] != '\"' || keyStr[keyStr.size() - 1] != '\"') { return false; } //  ERROR: invalid key
+            skip_whitespace();
+            if (!parse_value(maxDepth - 1)) { return false; } // ERROR: invalid value
 
-    // read value string
-    if (!ReadEntry(currentEntry, valueStr)) { return false; } // ERROR: invalid value
+            skip_whitespace();
+            char const c {peek()};
+            ++_pos;
+            if (c == '}') { return _handler.on_object_end(); }
+            if (c != ',') { return false; }
+        }
+    }
 
-    // unescape key
-    utf8_string const key {keyStr.substr(1, keyStr.size() - 2)};
-    obj.set_entry(key, currentEntry);
-    return true;
-}
+    auto parse_array(usize maxDepth) -> bool
+    {
+        if (maxDepth == 0) { return false; }
 
-auto json_reader::ReadEntry(entry& currentEntry, utf8_string_view line) -> bool
-{
-    return !line.empty()
-        && (ReadArray(currentEntry, line)
-            || ReadObject(currentEntry, line)
-            || ReadScalar(currentEntry, line));
-}
+        ++_pos; // '['
+        if (!_handler.on_array_begin()) { return false; }
 
-auto json_reader::ReadArray(entry& currentEntry, utf8_string_view line) -> bool
-{
-    auto const lineSize {line.size()};
-    if (lineSize < 2) { return false; }
-    if (line[0] != '[') { return false; }
-    if (line[lineSize - 1] != ']') { return false; }
+        skip_whitespace();
+        if (peek() == ']') {
+            ++_pos;
+            return _handler.on_array_end();
+        }
 
-    array arr {};
+        for (;;) {
+            skip_whitespace();
+            if (!parse_value(maxDepth - 1)) { return false; }
 
-    auto const splitLine {helper::trim(line.substr(1, lineSize - 2))};
-    if (splitLine.empty()) {
-        currentEntry.set_value(arr);
-        return true;
+            skip_whitespace();
+            char const c {peek()};
+            ++_pos;
+            if (c == ']') { return _handler.on_array_end(); }
+            if (c != ',') { return false; }
+        }
     }
 
-    if (!helper::split_preserve_brackets_for_each(
-            splitLine, ',',
-            [&arr](utf8_string_view token) {
-                auto const tk {helper::trim(token)};
-                entry      arrvalue;
-                if (ReadEntry(arrvalue, tk)) {
-                    arr.add_entry(arrvalue);
-                    return true;
+    // without escapes the result points into the source text, otherwise into _buffer
+    auto parse_string(utf8_string_view& out) -> bool
+    {
+        ++_pos; // '"'
+
+        char const* const begin {_txt.data() + _pos};
+        char const* const end {_txt.data() + _txt.size()};
+        char const*       it {find_string_special(begin, end)};
+        if (it == end) { return false; }
+
+        if (*it == '"') {
+            out = utf8_string_view {begin, static_cast<usize>(it - begin)};
+            _pos += static_cast<usize>(it - begin) + 1;
+            return true;
+        }
+
+        _buffer.assign(begin, it);
+        while (it != end) {
+            if (*it == '"') {
+                out = _buffer;
+                _pos = static_cast<usize>(it - _txt.data()) + 1;
+                return true;
+            }
+
+            // escape sequence
+            if (++it == end) { return false; }
+            switch (*it) {
+            case '"':  _buffer += '"'; break;
+            case '\\': _buffer += '\\'; break;
+            case '/':  _buffer += '/'; break;
+            case 'b':  _buffer += '\b'; break;
+            case 'f':  _buffer += '\f'; break;
+            case 'n':  _buffer += '\n'; break;
+            case 'r':  _buffer += '\r'; break;
+            case 't':  _buffer += '\t'; break;
+            case 'u': {
+                u32 cp {0};
+                if (!parse_hex4(it, end, cp)) { return false; }
+                if (cp >= 0xD800 && cp <= 0xDBFF && end - it > 6 && it[1] == '\\' && it[2] == 'u') {
+                    char const* low {it + 2};
+                    u32         lowCp {0};
+                    if (parse_hex4(low, end, lowCp) && lowCp >= 0xDC00 && lowCp <= 0xDFFF) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (lowCp - 0xDC00);
+                        it = low;
+                    }
                 }
+                append_utf8(_buffer, cp);
+            } break;
+            default: // keep unknown escapes verbatim
+                _buffer += '\\';
+                _buffer += *it;
+                break;
+            }
+            ++it;
+
+            char const* const next {find_string_special(it, end)};
+            _buffer.append(it, next);
+            it = next;
+        }
+
+        return false; // ERROR: unterminated string
+    }
 
+    static auto parse_hex4(char const*& it, char const* end, u32& cp) -> bool
+    {
+        if (end - it < 5) { return false; }
+
+        cp = 0;
+        for (i32 i {1}; i <= 4; ++i) {
+            char const c {it[i]};
+            cp <<= 4;
+            if (c >= '0' && c <= '9') {
+                cp |= static_cast<u32>(c - '0');
+            } else if (c >= 'a' && c <= 'f') {
+                cp |= static_cast<u32>(c - 'a' + 10);
+            } else if (c >= 'A' && c <= 'F') {
+                cp |= static_cast<u32>(c - 'A' + 10);
+            } else {
                 return false;
-            })) {
-        return false;
+            }
+        }
+
+        it += 4;
+        return true;
     }
 
-    currentEntry.set_value(arr);
-    return true;
-}
+    auto parse_literal(utf8_string_view literal) -> bool
+    {
+        if (_txt.substr(_pos, literal.size()) != literal) { return false; }
+        _pos += literal.size();
+        return true;
+    }
 
-auto json_reader::ReadObject(entry& currentEntry, utf8_string_view line) -> bool
-{
-    auto const lineSize {line.size()};
-    if (lineSize <= 1) { return false; }
-    if (line[0] != '{') { return false; }
-    if (line[lineSize - 1] != '}') { return false; }
+    auto parse_number() -> bool
+    {
+        usize const start {_pos};
+        while (_pos < _txt.size()) {
+            char const c {_txt[_pos]};
+            if ((c < '0' || c > '9') && c != '-' && c != '+' && c != '.' && c != 'e' && c != 'E') { break; }
+            ++_pos;
+        }
 
-    object obj {};
+        auto const token {_txt.substr(start, _pos - start)};
+        if (token.empty()) { return false; }
 
-    auto const splitLine {helper::trim(line.substr(1, lineSize - 2))};
-    if (splitLine.empty()) {
-        currentEntry.set_value(obj);
-        return true;
+        if (auto const intVal {helper::to_number<i64>(token)}) {
+            return _handler.on_int(*intVal);
+        }
+        if (auto const floatVal {helper::to_number<f64>(token)}) {
+            return _handler.on_float(*floatVal);
+        }
+
+        return false;
     }
 
-    if (helper::split_preserve_brackets_for_each(
-            splitLine, ',',
-            [&obj](utf8_string_view token) {
-                entry objValue;
-                return ReadKeyValuePair(obj, objValue, helper::trim(token));
-            })) {
-        currentEntry.set_value(obj);
+    utf8_string_view _txt;
+    usize            _pos {0};
+    Handler&         _handler;
+    utf8_string      _buffer;
+};
+
+////////////////////////////////////////////////////////////
+
+// Builds data::object/data::array directly from parser events.
+class json_dom_builder {
+public:
+    auto on_null() -> bool { return add(std::monostate {}); }
+    auto on_bool(bool value) -> bool { return add(value); }
+    auto on_int(i64 value) -> bool { return add(value); }
+    auto on_float(f64 value) -> bool { return add(value); }
+    auto on_string(utf8_string_view value) -> bool { return add(utf8_string {value}); }
+
+    auto on_key(utf8_string_view key) -> bool
+    {
+        _key = key;
         return true;
     }
 
-    return false;
-}
-
-auto json_reader::ReadScalar(entry& currentEntry, utf8_string_view line) -> bool
-{
-    // null
-    if (line == "null") {
-        currentEntry.set_value(std::monostate {});
+    auto on_object_begin() -> bool
+    {
+        object obj;
+        if (!add(obj)) { return false; }
+        _stack.push_back({.Object = obj, .Array = {}, .IsObject = true});
         return true;
     }
 
-    // bool
-    if (line == "true" || line == "false") {
-        currentEntry.set_value(line == "true");
+    auto on_object_end() -> bool
+    {
+        _stack.pop_back();
         return true;
     }
 
-    // int
-    if (auto const intVal {helper::to_number<i64>(line)}) {
-        currentEntry.set_value(*intVal);
+    auto on_array_begin() -> bool
+    {
+        array arr;
+        if (!add(arr)) { return false; }
+        _stack.push_back({.Object = {}, .Array = arr, .IsObject = false});
         return true;
     }
 
-    // float
-    if (auto const floatVal {helper::to_number<f64>(line)}) {
-        currentEntry.set_value(*floatVal);
+    auto on_array_end() -> bool
+    {
+        _stack.pop_back();
         return true;
     }
 
-    // string
-    auto const lineSize {line.size()};
-    if (lineSize > 1 && line[0] == '"' && line[lineSize - 1] == '"') {
-        currentEntry.set_value(utf8_string {line.substr(1, lineSize - 2)});
+    auto root() -> entry&
+    {
+        return _root;
+    }
+
+private:
+    struct frame {
+        object Object;
+        array  Array;
+        bool   IsObject {false};
+    };
+
+    template <typename T>
+    auto add(T const& value) -> bool
+    {
+        if (_stack.empty()) {
+            _root.set_value(value);
+            return true;
+        }
+
+        entry ent;
+        ent.set_value(value);
+
+        auto& top {_stack.back()};
+        if (top.IsObject) {
+            top.Object.set_entry(_key, ent);
+        } else {
+            top.Array.add_entry(ent);
+        }
         return true;
     }
 
-    return false;
+    entry              _root;
+    std::vector<frame> _stack;
+    utf8_string        _key;
+};
+
+static auto parse_entry(entry& currentEntry, utf8_string_view txt, char expected) -> bool
+{
+    json_dom_builder              builder;
+    json_parser<json_dom_builder> parser {txt, builder};
+    if (!parser.parse(expected)) { return false; }
+
+    currentEntry = builder.root();
+    return true;
 }
 
-//////////////////////////////////////////////////////////////////////
+////////////////////////////////////////////////////////////
 
-constexpr usize MAX_DEPTH {1000};
+auto json_reader::read_as_object(utf8_string_view txt) -> std::optional<object>
+{
+    entry currentEntry;
+    return ReadObject(currentEntry, txt) ? std::optional<object> {currentEntry.as<object>()} : std::nullopt;
+}
+
+auto json_reader::read_as_array(utf8_string_view txt) -> std::optional<array>
+{
+    entry currentEntry;
+    return ReadArray(currentEntry, txt) ? std::optional<array> {currentEntry.as<array>()} : std::nullopt;
+}
+
+auto json_reader::ReadArray(entry& currentEntry, utf8_string_view line) -> bool
+{
+    return parse_entry(currentEntry, line, '[');
+}
+
+auto json_reader::ReadObject(entry& currentEntry, utf8_string_view line) -> bool
+{
+    return parse_entry(currentEntry, line, '{');
+}
+
+//////////////////////////////////////////////////////////////////////
 
 auto json_writer::write(io::ostream& stream, object const& obj) -> bool
 {
@@ -193,6 +427,32 @@ auto json_writer::write(io::ostream& stream, array const& arr) -> bool
     return write_array(stream, 0, arr, MAX_DEPTH);
 }
 
+void json_writer::write_string(io::ostream& stream, utf8_string_view str) const
+{
+    stream << "\"";
+
+    usize start {0};
+    for (usize i {0}; i < str.size(); ++i) {
+        char const c {str[i]};
+        if (c != '"' && c != '\\' && static_cast<u8>(c) >= 0x20) { continue; }
+
+        stream << str.substr(start, i - start);
+        switch (c) {
+        case '"':  stream << "\\\""; break;
+        case '\\': stream << "\\\\"; break;
+        case '\n': stream << "\\n"; break;
+        case '\r': stream << "\\r"; break;
+        case '\t': stream << "\\t"; break;
+        case '\b': stream << "\\b"; break;
+        case '\f': stream << "\\f"; break;
+        default:   stream << std::format("\\u{:04x}", static_cast<u8>(c)); break;
+        }
+        start = i + 1;
+    }
+
+    stream << str.substr(start) << "\"";
+}
+
 auto json_writer::write_object(io::ostream& stream, usize indent, object const& obj, usize maxDepth) const -> bool
 {
     if (maxDepth == 0) { return false; }
@@ -204,7 +464,9 @@ auto json_writer::write_object(io::ostream& stream, usize indent, object const&
     bool first {true};
     for (auto const& [k, v] : obj) {
         if (!first) { stream << ", \n"; }
-        stream << indentEntry << "\"" << k << "\": ";
+        stream << indentEntry;
+        write_string(stream, k);
+        stream << ": ";
 
         if (!write_entry(stream, indent + INDENT_SPACES, v, maxDepth - 1)) { return false; }
 
@@ -250,7 +512,7 @@ auto json_writer::write_entry(io::ostream& stream, usize indent, entry const& en
     } else if (ent.is<f64>()) {
         stream << std::to_string(ent.as<f64>());
     } else if (ent.is<utf8_string>()) {
-        stream << "\"" << ent.as<utf8_string>() << "\"";
+        write_string(stream, ent.as<utf8_string>());
     } else if (ent.is<array>()) {
         return write_array(stream, indent, ent.as<array>(), maxDepth);
     } else if (ent.is<object>()) {
@@ -263,3 +525,15 @@ auto json_writer::write_entry(io::ostream& stream, usize indent, entry const& en
 }
 
 }
+
+////////////////////////////////////////////////////////////
+
+namespace tcob::data {
+
+auto parse_json(utf8_string_view json, json_sax_handler& handler) -> bool
+{
+    detail::json_parser<json_sax_handler> parser {json, handler};
+    return parser.parse(0);
+}
+
+}
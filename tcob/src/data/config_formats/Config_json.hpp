@@ -21,12 +21,6 @@ public:
 
     static auto ReadArray(entry& currentEntry, utf8_string_view line) -> bool;
     static auto ReadObject(entry& currentEntry, utf8_string_view line) -> bool;
-
-private:
-    static auto ReadKeyValuePair(object& obj, entry& currentEntry, utf8_string_view line) -> bool;
-
-    static auto ReadEntry(entry& currentEntry, utf8_string_view line) -> bool;
-    static auto ReadScalar(entry& currentEntry, utf8_string_view line) -> bool;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -37,6 +31,7 @@ public:
     auto write(io::ostream& stream, array const& arr) -> bool override;
 
 private:
+    void write_string(io::ostream& stream, utf8_string_view str) const;
     auto write_object(io::ostream& stream, usize indent, object const& obj, usize maxDepth) const -> bool;
     auto write_array(io::ostream& stream, usize indent, array const& arr, usize maxDepth) const -> bool;
     auto write_entry(io::ostream& stream, usize indent, entry const& ent, usize maxDepth) const -> bool;
@@ -117,6 +117,11 @@ static void MultiplyAlphaPaint(paint_color& c, f32 alpha)
     }
 }
 
+static auto RegionOrDefault(texture_region const* region) -> texture_region
+{
+    return region ? *region : texture_region {};
+}
+
 ////////////////////////////////////////////////////////////
 
 canvas::canvas()
@@ -1043,6 +1048,26 @@ void canvas::set_text_valign(vertical_alignment align)
 ////////////////////////////////////////////////////////////
 
 void canvas::draw_image(texture* image, string const& region, rect_f const& rect)
+{
+    draw_image_region(image, RegionOrDefault(image->regions().find(region)), rect);
+}
+
+void canvas::draw_image(texture* image, texture_region_handle const& region, rect_f const& rect)
+{
+    draw_image_region(image, RegionOrDefault(image->regions().find(region)), rect);
+}
+
+void canvas::draw_nine_patch(texture* image, string const& region, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV)
+{
+    draw_nine_patch_region(image, RegionOrDefault(image->regions().find(region)), rect, center, localCenterUV);
+}
+
+void canvas::draw_nine_patch(texture* image, texture_region_handle const& region, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV)
+{
+    draw_nine_patch_region(image, RegionOrDefault(image->regions().find(region)), rect, center, localCenterUV);
+}
+
+void canvas::draw_image_region(texture* image, texture_region const& texRegion, rect_f const& rect)
 {
     state const& s {_states->get()};
     paint        paint {s.Fill}; // copy
@@ -1053,8 +1078,6 @@ void canvas::draw_image(texture* image, string const& region, rect_f const& rect
     // Apply global alpha
     MultiplyAlphaPaint(paint.Color, s.Alpha);
 
-    texture_region texRegion {paint.Image->regions()[region]};
-
     quad quad {};
     geometry::set_position(quad, rect, s.XForm);
     geometry::set_color(quad, colors::White);
@@ -1069,7 +1092,7 @@ void canvas::draw_image(texture* image, string const& region, rect_f const& rect
     _impl->render_triangles(paint, s.CompositeOperation, s.Scissor, _fringeWidth, verts);
 }
 
-void canvas::draw_nine_patch(texture* image, string const& region, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV)
+void canvas::draw_nine_patch_region(texture* image, texture_region const& texRegion, rect_f const& rect, rect_f const& center, rect_f const& localCenterUV)
 {
     state const& s {_states->get()};
     auto         paint {s.Fill}; // copy
@@ -1090,9 +1113,8 @@ void canvas::draw_nine_patch(texture* image, string const& region, rect_f const&
     f32 const bottomCenter {center.bottom()};
     f32 const bottom {rect.bottom()};
 
-    texture_region texRegion {paint.Image->regions()[region]};
-    rect_f const&  uvRect {texRegion.UVRect};
-    u32 const      level {texRegion.Level};
+    rect_f const& uvRect {texRegion.UVRect};
+    u32 const     level {texRegion.Level};
 
     f32 const uv_left {uvRect.left()};
     f32 const uv_leftCenter {uvRect.left() + localCenterUV.left()};
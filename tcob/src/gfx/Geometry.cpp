@@ -110,15 +110,25 @@ void set_texcoords(quad& q, texture_region const& region, bool flipHorizontally,
     q[3].TexCoords = topLeft;
 }
 
-void set_texcoords(quad& q, pass const& pass, string const& region, bool flipHorizontally, bool flipVertically)
+static void SetTexcoords(quad& q, texture_region const* texRegion, bool flipHorizontally, bool flipVertically)
 {
-    if (pass.Texture && pass.Texture->regions().contains(region)) {
-        geometry::set_texcoords(q, pass.Texture->regions()[region], flipHorizontally, flipVertically);
+    if (texRegion) {
+        geometry::set_texcoords(q, *texRegion, flipHorizontally, flipVertically);
     } else {
         geometry::set_texcoords(q, {.UVRect = {0, 0, 1, 1}, .Level = 0});
     }
 }
 
+void set_texcoords(quad& q, pass const& pass, string const& region, bool flipHorizontally, bool flipVertically)
+{
+    SetTexcoords(q, pass.Texture ? pass.Texture->regions().find(region) : nullptr, flipHorizontally, flipVertically);
+}
+
+void set_texcoords(quad& q, pass const& pass, texture_region_handle const& region, bool flipHorizontally, bool flipVertically)
+{
+    SetTexcoords(q, pass.Texture ? pass.Texture->regions().find(region) : nullptr, flipHorizontally, flipVertically);
+}
+
 void scroll_texcoords(quad& q, point_f offset)
 {
     f32 const left {q[3].TexCoords.U + offset.X};
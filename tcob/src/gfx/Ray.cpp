@@ -5,10 +5,12 @@
 
 #include "tcob/gfx/Ray.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
 #include <limits>
 #include <optional>
+#include <utility>
 #include <vector>
 
 #include "tcob/core/AngleUnits.hpp"
@@ -127,6 +129,28 @@ auto ray::intersect_polyline(polyline_span polygon, transform const& xform) cons
     return intersect_polyline(points);
 }
 
+auto ray::intersect_aabb(rect_f const& rect, f64 maxDistance) const -> std::optional<f64>
+{
+    // slab test, the ray only has to enter the rect before the max distance
+    f64 tMin {0.0};
+    f64 tMax {std::min(maxDistance, _maxDistance)};
+
+    auto const slab {[&](f64 origin, f64 dir, f64 low, f64 high) {
+        if (std::abs(dir) < epsilon) { return origin >= low && origin <= high; }
+
+        f64 t0 {(low - origin) / dir};
+        f64 t1 {(high - origin) / dir};
+        if (t0 > t1) { std::swap(t0, t1); }
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        return tMin <= tMax;
+    }};
+
+    if (!slab(_origin.X, _direction.X, rect.left(), rect.right())) { return std::nullopt; }
+    if (!slab(_origin.Y, _direction.Y, rect.top(), rect.bottom())) { return std::nullopt; }
+    return tMin;
+}
+
 auto ray::intersect_segment(point_d const& rd, point_d const& p0, point_d const& p1) const -> std::optional<f64>
 {
     point_d const ro {_origin};
@@ -0,0 +1,228 @@
+// Copyright (c) 2025 Tobias Bohnen
+//
+// This software is released under the MIT License.
+// https://opensource.org/licenses/MIT
+
+#include "tcob/gfx/RenderQueue.hpp"
+
+#include <algorithm>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "tcob/core/ServiceLocator.hpp"
+#include "tcob/gfx/Geometry.hpp"
+#include "tcob/gfx/Gfx.hpp"
+#include "tcob/gfx/Material.hpp"
+#include "tcob/gfx/RenderSystem.hpp"
+#include "tcob/gfx/RenderTarget.hpp"
+#include "tcob/gfx/Stats.hpp"
+#include "tcob/gfx/drawables/Drawable.hpp"
+
+namespace tcob::gfx {
+
+static constexpr u64 MaxPassIndex {0xF};
+static constexpr u64 MaxResourceId {0x3FFF};
+
+static auto DepthBits(f32 depth) -> u64
+{
+    return static_cast<u64>(std::clamp(depth, 0.0f, 1.0f) * 0xFF'FFFF);
+}
+
+render_queue::render_queue()
+    : render_queue {&locate_service<render_system>().statistics()}
+{
+}
+
+render_queue::render_queue(render_statistics* stats)
+    : _stats {stats}
+    , _vertexArray {buffer_usage_hint::DynamicDraw}
+{
+}
+
+void render_queue::submit(geometry_data const& gd, material const& material, isize passIndex, u8 layer, f32 depth)
+{
+    if (passIndex < 0 || passIndex >= material.pass_count() || gd.Vertices.empty() || gd.Indices.empty()) { return; }
+
+    submit_command(material.get_pass(passIndex), passIndex, gd.Type, static_cast<u32>(gd.Indices.size()), layer, depth);
+
+    _verts.insert(_verts.end(), gd.Vertices.begin(), gd.Vertices.end());
+    _commandIndices.insert(_commandIndices.end(), gd.Indices.begin(), gd.Indices.end());
+}
+
+void render_queue::submit(std::span<quad const> quads, material const& material, isize passIndex, u8 layer, f32 depth)
+{
+    if (passIndex < 0 || passIndex >= material.pass_count() || quads.empty()) { return; }
+
+    submit_command(material.get_pass(passIndex), passIndex, primitive_type::Triangles, static_cast<u32>(quads.size() * 6), layer, depth);
+
+    _verts.insert(_verts.end(), &quads[0][0], &quads[0][0] + (quads.size() * 4));
+    for (u32 i {0}, j {0}; i < quads.size(); ++i, j += 4) {
+        _commandIndices.insert(_commandIndices.end(), {3 + j, 1 + j, 0 + j, 3 + j, 2 + j, 1 + j});
+    }
+}
+
+void render_queue::submit(drawable& drawable, u8 layer, f32 depth)
+{
+    // the drawable gets a segment of its own, so geometry submitted before it stays before it
+    u32& segment {_segments[layer]};
+    _commands.push_back({.Key = (static_cast<u64>(layer) << 56) | DepthBits(depth), .Segment = ++segment, .Drawable = &drawable});
+    ++segment;
+    _isPrepared = false;
+}
+
+void render_queue::submit_command(pass const& pass, isize passIndex, primitive_type type, u32 numInds, u8 layer, f32 depth)
+{
+    _commands.push_back({.Key         = make_key(pass, passIndex, layer, depth),
+                         .Segment     = _segments[layer],
+                         .Pass        = &pass,
+                         .Type        = type,
+                         .OffsetVerts = static_cast<u32>(_verts.size()),
+                         .NumInds     = numInds,
+                         .OffsetInds  = static_cast<u32>(_commandIndices.size())});
+    _isPrepared = false;
+}
+
+void render_queue::clear()
+{
+    _verts.clear();
+    _commandIndices.clear();
+    _commands.clear();
+    _indices.clear();
+    _batches.clear();
+    _resourceIds.clear();
+    _segments.fill(0);
+    _isPrepared = false;
+}
+
+auto render_queue::make_key(pass const& pass, isize passIndex, u8 layer, f32 depth) -> u64
+{
+    // later passes of a material always draw after the earlier ones
+    u64 const index {std::min(static_cast<u64>(std::max<isize>(passIndex, 0)), MaxPassIndex)};
+    u64 const shader {resource_id(pass.Shader.get())};
+    u64 const texture {resource_id(pass.Texture.get())};
+    return (static_cast<u64>(layer) << 56) | (index << 52) | (shader << 38) | (texture << 24) | DepthBits(depth);
+}
+
+auto render_queue::resource_id(void const* ptr) -> u64
+{
+    if (!ptr) { return 0; }
+
+    // ids are handed out in first seen order and forgotten on clear
+    auto [it, inserted] {_resourceIds.try_emplace(ptr, 0)};
+    if (inserted) { it->second = std::min<u64>(_resourceIds.size(), MaxResourceId); }
+    return it->second;
+}
+
+void render_queue::prepare()
+{
+    if (_isPrepared) { return; }
+    _isPrepared = true;
+
+    _order.resize(_commands.size());
+    for (u32 i {0}; i < _order.size(); ++i) { _order[i] = i; }
+    std::ranges::stable_sort(_order, {}, [this](u32 idx) {
+        auto const& cmd {_commands[idx]};
+        return std::pair {((cmd.Key >> 56) << 32) | cmd.Segment, cmd.Key};
+    });
+
+    _indices.clear();
+    _indices.reserve(_commandIndices.size());
+    _batches.clear();
+
+    for (u32 const idx : _order) {
+        auto const& cmd {_commands[idx]};
+        if (cmd.Drawable) {
+            _batches.push_back({.Drawable = cmd.Drawable});
+            continue;
+        }
+
+        // equal passes merge, even across materials and drawables
+        if (_batches.empty() || _batches.back().Drawable || _batches.back().Type != cmd.Type || *_batches.back().Pass != *cmd.Pass) {
+            _batches.push_back({.Pass = cmd.Pass, .Type = cmd.Type, .OffsetInds = static_cast<u32>(_indices.size())});
+        }
+
+        auto& batch {_batches.back()};
+        for (u32 i {0}; i < cmd.NumInds; ++i) {
+            _indices.push_back(_commandIndices[cmd.OffsetInds + i] + cmd.OffsetVerts);
+        }
+        batch.NumInds += cmd.NumInds;
+    }
+}
+
+auto render_queue::batches() const -> std::span<batch const>
+{
+    return _batches;
+}
+
+auto render_queue::draw_call_count() const -> u32
+{
+    return static_cast<u32>(std::ranges::count_if(_batches, [](batch const& b) { return b.Drawable == nullptr; }));
+}
+
+auto render_queue::state_change_count() const -> u32
+{
+    u32         retValue {0};
+    pass const* bound {nullptr};
+    for (auto const& batch : _batches) {
+        if (batch.Drawable) {
+            bound = nullptr;
+            continue;
+        }
+        if (!bound || *bound != *batch.Pass) {
+            bound = batch.Pass;
+            ++retValue;
+        }
+    }
+    return retValue;
+}
+
+void render_queue::on_render_to_target(render_target& target)
+{
+    if (_commands.empty()) { return; }
+
+    prepare();
+
+    if (!_verts.empty()) {
+        // grow geometrically, the queue is refilled every frame
+        if (_verts.size() > _vertCapacity || _indices.size() > _indCapacity) {
+            _vertCapacity = std::max(_verts.size(), _vertCapacity * 2);
+            _indCapacity  = std::max(_indices.size(), _indCapacity * 2);
+            _vertexArray.resize(_vertCapacity, _indCapacity);
+        }
+        _vertexArray.update_data(_verts, 0);
+        _vertexArray.update_data(_indices, 0);
+    }
+
+    u32         drawCalls {0};
+    u32         stateChanges {0};
+    pass const* bound {nullptr};
+    for (auto const& batch : _batches) {
+        if (batch.Drawable) {
+            if (bound) {
+                target.unbind_pass();
+                bound = nullptr;
+            }
+            batch.Drawable->draw_to(target);
+            continue;
+        }
+
+        if (!bound || *bound != *batch.Pass) {
+            if (bound) { target.unbind_pass(); }
+            target.bind_pass(*batch.Pass);
+            bound = batch.Pass;
+            ++stateChanges;
+        }
+        _vertexArray.draw_elements(batch.Type, batch.NumInds, batch.OffsetInds);
+        ++drawCalls;
+    }
+
+    if (bound) { target.unbind_pass(); }
+
+    if (_stats) {
+        _stats->add_draw_calls(drawCalls);
+        _stats->add_state_changes(stateChanges);
+    }
+}
+
+}
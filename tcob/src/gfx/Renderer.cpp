@@ -5,7 +5,9 @@
 
 #include "tcob/gfx/Renderer.hpp"
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <span>
 #include <utility>
 #include <vector>
@@ -143,6 +145,61 @@ void quad_renderer::on_render_to_target(render_target& target)
 
 ////////////////////////////////////////////////////////////
 
+indexed_quad_renderer::indexed_quad_renderer(buffer_usage_hint usage)
+    : _vertexArray {usage}
+{
+}
+
+void indexed_quad_renderer::resize(usize quadCount)
+{
+    _vertexArray.resize(quadCount * 4, quadCount * 6);
+    _capacity   = quadCount;
+    _numIndices = 0;
+}
+
+void indexed_quad_renderer::update_geometry(std::span<quad const> quads, usize quadOffset)
+{
+    assert(quadOffset + quads.size() <= _capacity);
+    _vertexArray.update_data(quads, quadOffset);
+}
+
+void indexed_quad_renderer::set_order(std::span<u32 const> quadIndices)
+{
+    assert(quadIndices.size() <= _capacity);
+
+    _indices.resize(quadIndices.size() * 6);
+    for (usize i {0}; i < quadIndices.size(); ++i) {
+        u32 const j {quadIndices[i] * 4};
+        _indices[(i * 6) + 0] = 3 + j;
+        _indices[(i * 6) + 1] = 1 + j;
+        _indices[(i * 6) + 2] = 0 + j;
+        _indices[(i * 6) + 3] = 3 + j;
+        _indices[(i * 6) + 4] = 2 + j;
+        _indices[(i * 6) + 5] = 1 + j;
+    }
+
+    if (!_indices.empty()) { _vertexArray.update_data(_indices, 0); }
+    _numIndices = _indices.size();
+}
+
+void indexed_quad_renderer::set_pass(pass const* pass)
+{
+    _pass = pass;
+}
+
+void indexed_quad_renderer::on_render_to_target(render_target& target)
+{
+    if (_numIndices == 0 || !_pass) {
+        return;
+    }
+
+    target.bind_pass(*_pass);
+    _vertexArray.draw_elements(primitive_type::Triangles, _numIndices, 0);
+    target.unbind_pass();
+}
+
+////////////////////////////////////////////////////////////
+
 polygon_renderer::polygon_renderer(buffer_usage_hint usage)
     : _vertexArray {usage}
 {
@@ -196,66 +253,195 @@ batch_polygon_renderer::batch_polygon_renderer()
 {
 }
 
-void batch_polygon_renderer::add_geometry(geometry_data const& gd, pass const* pass)
+auto batch_polygon_renderer::add_geometry(geometry_data const& gd, pass const* pass) -> u32
 {
-    // check if we have to break the batch
-    if (_currentBatch.NumInds > 0 && (_currentBatch.Type != gd.Type || *_currentBatch.Pass != *pass)) {
-        _batches.push_back(_currentBatch);
-        _currentBatch.OffsetInds += _currentBatch.NumInds;
-        _currentBatch.OffsetVerts += _currentBatch.NumVerts;
-        _currentBatch.NumInds  = 0;
-        _currentBatch.NumVerts = 0;
+    u32 id {0};
+    if (_freeSlots.empty()) {
+        id = static_cast<u32>(_slots.size());
+        _slots.emplace_back();
+    } else {
+        id = _freeSlots.back();
+        _freeSlots.pop_back();
+    }
+    _order.push_back(id);
+
+    auto& s {_slots[id]};
+    s = {.Pass        = pass,
+         .Type        = gd.Type,
+         .NumVerts    = static_cast<u32>(gd.Vertices.size()),
+         .NumInds     = static_cast<u32>(gd.Indices.size()),
+         .OffsetVerts = static_cast<u32>(_verts.size()),
+         .OffsetInds  = static_cast<u32>(_indices.size()),
+         .Alive       = true};
+
+    // no exact reserve here, it would defeat the geometric growth and make bulk adds quadratic
+    _verts.insert(_verts.end(), gd.Vertices.begin(), gd.Vertices.end());
+    for (auto const& ind : gd.Indices) {
+        _indices.push_back(ind + s.OffsetVerts);
     }
 
-    _currentBatch.Pass = pass;
-    _currentBatch.Type = gd.Type;
+    add_to_batches(s);
 
-    // copy indices
-    if (!_verts.empty()) {
-        _indices.reserve(_indices.size() + gd.Indices.size());
-        for (auto const& ind : gd.Indices) {
-            _indices.push_back(static_cast<u32>(ind + _verts.size()));
-        }
-    } else {
-        _indices.insert(_indices.end(), gd.Indices.begin(), gd.Indices.end());
+    _dirtyVerts.push_back({.Offset = s.OffsetVerts, .Count = s.NumVerts});
+    _dirtyInds.push_back({.Offset = s.OffsetInds, .Count = s.NumInds});
+    return id;
+}
+
+auto batch_polygon_renderer::update_geometry(u32 slot, geometry_data const& gd, pass const* pass) -> bool
+{
+    assert(slot < _slots.size() && _slots[slot].Alive);
+
+    auto const& s {_slots[slot]};
+    if (s.Pass != pass || s.Type != gd.Type || s.NumVerts != gd.Vertices.size() || s.NumInds != gd.Indices.size()) { return false; }
+
+    std::ranges::copy(gd.Vertices, _verts.begin() + s.OffsetVerts);
+    for (usize i {0}; i < gd.Indices.size(); ++i) {
+        _indices[s.OffsetInds + i] = gd.Indices[i] + s.OffsetVerts;
     }
-    _currentBatch.NumInds += static_cast<u32>(gd.Indices.size());
 
-    // copy vertices
-    _verts.insert(_verts.end(), gd.Vertices.begin(), gd.Vertices.end());
-    _currentBatch.NumVerts += static_cast<u32>(gd.Vertices.size());
+    _dirtyVerts.push_back({.Offset = s.OffsetVerts, .Count = s.NumVerts});
+    _dirtyInds.push_back({.Offset = s.OffsetInds, .Count = s.NumInds});
+    return true;
+}
 
-    _vertexArray.resize(_verts.size(), _indices.size());
+void batch_polygon_renderer::remove_geometry(u32 slot)
+{
+    assert(slot < _slots.size() && _slots[slot].Alive);
+
+    // the batches are rebuilt around the hole, its vertices and indices stay until the next compaction
+    auto& s {_slots[slot]};
+    s.Alive = false;
+
+    _deadVerts += s.NumVerts;
+    ++_deadSlots;
+    _batchesDirty = true;
 }
 
 void batch_polygon_renderer::reset_geometry()
 {
+    _slots.clear();
+    _order.clear();
+    _freeSlots.clear();
     _batches.clear();
-    _currentBatch = {};
+    _batchesDirty = false;
+    _deadVerts    = 0;
+    _deadSlots    = 0;
 
     _verts.clear();
     _indices.clear();
+
+    _dirtyVerts.clear();
+    _dirtyInds.clear();
+    _uploadAll = true;
 }
 
-void batch_polygon_renderer::on_render_to_target(render_target& target)
+void batch_polygon_renderer::compact()
 {
-    if (_currentBatch.NumVerts == 0 && _batches.empty()) { // nothing to draw
-        return;
+    std::vector<vertex> verts;
+    std::vector<u32>    indices;
+    verts.reserve(_verts.size() - _deadVerts);
+    indices.reserve(_indices.size());
+
+    std::erase_if(_order, [&](u32 id) {
+        auto& s {_slots[id]};
+        if (!s.Alive) {
+            _freeSlots.push_back(id);
+            return true;
+        }
+
+        u32 const offsetVerts {static_cast<u32>(verts.size())};
+        u32 const offsetInds {static_cast<u32>(indices.size())};
+        verts.insert(verts.end(), _verts.begin() + s.OffsetVerts, _verts.begin() + s.OffsetVerts + s.NumVerts);
+        for (u32 i {0}; i < s.NumInds; ++i) {
+            indices.push_back(_indices[s.OffsetInds + i] - s.OffsetVerts + offsetVerts);
+        }
+        s.OffsetVerts = offsetVerts;
+        s.OffsetInds  = offsetInds;
+        return false;
+    });
+
+    _verts        = std::move(verts);
+    _indices      = std::move(indices);
+    _deadVerts    = 0;
+    _deadSlots    = 0;
+    _uploadAll    = true;
+    _batchesDirty = true;
+}
+
+void batch_polygon_renderer::rebuild_batches()
+{
+    _batches.clear();
+    for (u32 const id : _order) {
+        if (_slots[id].Alive) { add_to_batches(_slots[id]); }
     }
+    _batchesDirty = false;
+}
 
-    if (_currentBatch.NumVerts > 0) { // push current batch
-        _batches.push_back(_currentBatch);
-        _currentBatch = {};
+void batch_polygon_renderer::add_to_batches(slot const& s)
+{
+    // batches never span the indices of removed slots
+    if (!_batches.empty() && _batches.back().OffsetInds + _batches.back().NumInds == s.OffsetInds
+        && _batches.back().Type == s.Type && *_batches.back().Pass == *s.Pass) {
+        _batches.back().NumInds = s.OffsetInds + s.NumInds - _batches.back().OffsetInds;
+    } else {
+        _batches.push_back({.Pass = s.Pass, .Type = s.Type, .NumInds = s.NumInds, .OffsetInds = s.OffsetInds});
+    }
+}
 
+void batch_polygon_renderer::upload()
+{
+    // growing the buffers discards their content
+    if (_verts.size() > _vertCapacity || _indices.size() > _indCapacity) {
+        _vertCapacity = std::max(_verts.size(), _vertCapacity * 2);
+        _indCapacity  = std::max(_indices.size(), _indCapacity * 2);
+        _vertexArray.resize(_vertCapacity, _indCapacity);
+        _uploadAll = true;
+    }
+
+    if (_uploadAll) {
         _vertexArray.update_data(_indices, 0);
         _vertexArray.update_data(_verts, 0);
+        _uploadAll = false;
+        _dirtyVerts.clear();
+        _dirtyInds.clear();
+        return;
     }
 
+    // merge nearby ranges, one larger upload is cheaper than many tiny ones
+    auto const flush {[&]<typename T>(std::vector<range>& ranges, std::vector<T> const& data) {
+        if (ranges.empty()) { return; }
+
+        std::ranges::sort(ranges, {}, &range::Offset);
+        range current {ranges.front()};
+        for (usize i {1}; i <= ranges.size(); ++i) {
+            if (i < ranges.size() && ranges[i].Offset <= current.Offset + current.Count + 64) {
+                current.Count = std::max(current.Count, ranges[i].Offset + ranges[i].Count - current.Offset);
+                continue;
+            }
+
+            _vertexArray.update_data(std::span<T const> {data}.subspan(current.Offset, current.Count), current.Offset);
+            if (i < ranges.size()) { current = ranges[i]; }
+        }
+        ranges.clear();
+    }};
+    flush(_dirtyInds, _indices);
+    flush(_dirtyVerts, _verts);
+}
+
+void batch_polygon_renderer::on_render_to_target(render_target& target)
+{
+    static constexpr usize MaxDeadSlots {32};
+    if (_deadVerts * 4 > _verts.size() || _deadSlots > MaxDeadSlots) { compact(); }
+    if (_batchesDirty) { rebuild_batches(); }
+    if (_batches.empty()) { return; } // nothing to draw
+
+    upload();
+
     for (auto const& batch : _batches) { // draw batches
-        if (batch.NumVerts == 0 || !batch.Pass) { continue; }
+        if (batch.NumInds == 0 || !batch.Pass) { continue; }
 
         target.bind_pass(*batch.Pass);
-        _vertexArray.draw_elements(primitive_type::Triangles, batch.NumInds, batch.OffsetInds);
+        _vertexArray.draw_elements(batch.Type, batch.NumInds, batch.OffsetInds);
         target.unbind_pass();
     }
 }
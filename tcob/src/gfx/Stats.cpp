@@ -8,6 +8,7 @@
 #include <algorithm>
 #include <limits>
 #include <numeric>
+#include <utility>
 
 namespace tcob::gfx {
 auto render_statistics::current_time() const -> f32
@@ -30,8 +31,31 @@ auto render_statistics::worst_FPS() const -> f32
     return _worstFrames;
 }
 
+auto render_statistics::draw_calls() const -> u32
+{
+    return _drawCalls;
+}
+
+auto render_statistics::state_changes() const -> u32
+{
+    return _stateChanges;
+}
+
+void render_statistics::add_draw_calls(u32 count)
+{
+    _frameDrawCalls += count;
+}
+
+void render_statistics::add_state_changes(u32 count)
+{
+    _frameStateChanges += count;
+}
+
 void render_statistics::update(milliseconds delta)
 {
+    _drawCalls    = std::exchange(_frameDrawCalls, 0);
+    _stateChanges = std::exchange(_frameStateChanges, 0);
+
     f32 const count {static_cast<f32>(delta.count())};
 
     _time += count;
@@ -56,5 +80,10 @@ void render_statistics::reset()
 
     _frameTimes.fill(0);
     _frameCount = 0;
+
+    _drawCalls         = 0;
+    _stateChanges      = 0;
+    _frameDrawCalls    = 0;
+    _frameStateChanges = 0;
 }
 }
@@ -5,10 +5,15 @@
 
 #include "tcob/gfx/Texture.hpp"
 
+#include <cassert>
 #include <chrono>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <span>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "tcob/core/Common.hpp"
 #include "tcob/core/Point.hpp"
@@ -27,6 +32,187 @@ using namespace std::chrono_literals;
 
 ////////////////////////////////////////////////////////////
 
+static constexpr u32 InvalidHandle {std::numeric_limits<u32>::max()};
+
+struct region_names {
+    std::mutex                      Mutex;
+    std::unordered_map<string, u32> Ids;
+    std::vector<string>             Names;
+    std::vector<u32>                RefCounts;
+    std::vector<u32>                FreeIds;
+};
+
+static auto GetRegionNames() -> region_names&
+{
+    static auto* names {new region_names}; // never destroyed, handles in static objects may outlive it
+    return *names;
+}
+
+texture_region_handle::texture_region_handle(string const& name)
+{
+    auto& names {GetRegionNames()};
+    std::scoped_lock lock {names.Mutex};
+
+    if (auto it {names.Ids.find(name)}; it != names.Ids.end()) {
+        _id = it->second;
+        ++names.RefCounts[_id];
+        return;
+    }
+
+    if (names.FreeIds.empty()) {
+        _id = static_cast<u32>(names.Names.size());
+        names.Names.push_back(name);
+        names.RefCounts.push_back(1);
+    } else {
+        _id = names.FreeIds.back();
+        names.FreeIds.pop_back();
+        names.Names[_id]     = name;
+        names.RefCounts[_id] = 1;
+    }
+    names.Ids.emplace(name, _id);
+}
+
+texture_region_handle::texture_region_handle(texture_region_handle const& other)
+    : _id {other._id}
+{
+    if (!is_valid()) { return; }
+
+    auto& names {GetRegionNames()};
+    std::scoped_lock lock {names.Mutex};
+    ++names.RefCounts[_id];
+}
+
+texture_region_handle::texture_region_handle(texture_region_handle&& other) noexcept
+    : _id {std::exchange(other._id, InvalidHandle)}
+{
+}
+
+texture_region_handle::~texture_region_handle()
+{
+    release();
+}
+
+auto texture_region_handle::operator=(texture_region_handle const& other) -> texture_region_handle&
+{
+    if (this != &other) {
+        texture_region_handle copy {other};
+        std::swap(_id, copy._id);
+    }
+    return *this;
+}
+
+auto texture_region_handle::operator=(texture_region_handle&& other) noexcept -> texture_region_handle&
+{
+    if (this != &other) {
+        release();
+        _id = std::exchange(other._id, InvalidHandle);
+    }
+    return *this;
+}
+
+void texture_region_handle::release()
+{
+    if (!is_valid()) { return; }
+
+    auto& names {GetRegionNames()};
+    std::scoped_lock lock {names.Mutex};
+    if (--names.RefCounts[_id] == 0) {
+        names.Ids.erase(names.Names[_id]);
+        names.Names[_id].clear();
+        names.FreeIds.push_back(_id);
+    }
+    _id = InvalidHandle;
+}
+
+auto texture_region_handle::is_valid() const -> bool
+{
+    return _id != InvalidHandle;
+}
+
+auto texture_region_handle::name() const -> string
+{
+    if (!is_valid()) { return ""; }
+
+    auto& names {GetRegionNames()};
+    std::scoped_lock lock {names.Mutex};
+    return names.Names[_id];
+}
+
+auto texture_region_handle::Find(string const& name) -> texture_region_handle
+{
+    auto& names {GetRegionNames()};
+    std::scoped_lock lock {names.Mutex};
+
+    texture_region_handle retValue;
+    if (auto it {names.Ids.find(name)}; it != names.Ids.end()) {
+        retValue._id = it->second;
+        ++names.RefCounts[retValue._id];
+    }
+    return retValue;
+}
+
+////////////////////////////////////////////////////////////
+
+static constexpr u32 NoRegion {std::numeric_limits<u32>::max()};
+
+auto texture_region_map::operator[](string const& name) -> texture_region&
+{
+    if (auto it {_names.find(name)}; it != _names.end()) { return _regions[it->second]; }
+    return insert(name, texture_region_handle {name});
+}
+
+auto texture_region_map::operator[](texture_region_handle const& handle) -> texture_region&
+{
+    assert(handle.is_valid());
+
+    if (u32 const index {index_of(handle)}; index != NoRegion) { return _regions[index]; }
+    return insert(handle.name(), handle);
+}
+
+auto texture_region_map::contains(string const& name) const -> bool
+{
+    return _names.contains(name);
+}
+
+auto texture_region_map::contains(texture_region_handle const& handle) const -> bool
+{
+    return index_of(handle) != NoRegion;
+}
+
+auto texture_region_map::find(string const& name) const -> texture_region const*
+{
+    auto const it {_names.find(name)};
+    return it != _names.end() ? &_regions[it->second] : nullptr;
+}
+
+auto texture_region_map::find(texture_region_handle const& handle) const -> texture_region const*
+{
+    u32 const index {index_of(handle)};
+    return index != NoRegion ? &_regions[index] : nullptr;
+}
+
+auto texture_region_map::index_of(texture_region_handle const& handle) const -> u32
+{
+    return handle._id < _slots.size() ? _slots[handle._id] : NoRegion; // also catches invalid handles
+}
+
+auto texture_region_map::insert(string const& name, texture_region_handle const& handle) -> texture_region&
+{
+    u32 const index {static_cast<u32>(_regions.size())};
+    _names.emplace(name, index);
+    if (handle._id >= _slots.size()) { _slots.resize(handle._id + 1, NoRegion); }
+    _slots[handle._id] = index;
+    _handles.push_back(handle);
+    return _regions.emplace_back();
+}
+
+auto texture_region_map::size() const -> usize
+{
+    return _regions.size();
+}
+
+////////////////////////////////////////////////////////////
+
 texture::texture()
     : Filtering {make_prop_fn<filtering,
                               [](texture const& t) { return t._impl->get_filtering(); },
@@ -16,10 +16,14 @@
 namespace tcob::gfx {
 
 background::background()
+    : _textureRegion {*TextureRegion}
 {
     Material.Changed.connect([this](auto const&) {
         TextureRegion("default");
     });
+    TextureRegion.Changed.connect([this](auto const& value) {
+        _textureRegion = texture_region_handle {value};
+    });
 }
 
 auto background::can_draw() const -> bool
@@ -37,7 +41,7 @@ void background::on_draw_to(render_target& target)
     for (isize i {0}; i < Material->pass_count(); ++i) {
         auto const& pass {Material->get_pass(i)};
 
-        geometry::set_texcoords(_quad, pass, TextureRegion);
+        geometry::set_texcoords(_quad, pass, _textureRegion);
 
         _renderer.set_geometry(_quad, &pass);
         _renderer.render_to_target(target);
@@ -91,8 +95,9 @@ void parallax_background::on_draw_to(render_target& target)
             geometry::set_position(quad, {point_f::Zero, size_f {*target.Size}});
             geometry::set_color(quad, colors::White);
 
-            if (pass.Texture && pass.Texture->regions().contains(layer.TextureRegion)) {
-                auto  texReg {pass.Texture->regions()[layer.TextureRegion]};
+            texture_region const* region {pass.Texture ? pass.Texture->regions().find(layer.TextureRegion) : nullptr};
+            if (region) {
+                auto  texReg {*region};
                 auto& uvRect {texReg.UVRect};
                 uvRect.Size *= (targetSize / texSize);
 
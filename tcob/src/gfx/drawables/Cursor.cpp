@@ -37,7 +37,7 @@ cursor::cursor()
 
 void cursor::add_mode(string const& name, point_i hotspot)
 {
-    _modes[name] = {hotspot};
+    _modes[name] = {.Hotspot = hotspot, .Region = texture_region_handle {name}};
 }
 
 auto cursor::has_mode(string const& name) const -> bool
@@ -65,8 +65,7 @@ void cursor::on_draw_to(render_target& target)
     for (isize i {0}; i < Material->pass_count(); ++i) {
         auto const& pass {Material->get_pass(i)};
 
-        auto const& region {pass.Texture->regions()[ActiveMode]};
-        geometry::set_texcoords(_quad, region);
+        geometry::set_texcoords(_quad, pass, _currentMode.Region);
         _renderer.set_geometry(_quad, &pass);
         _renderer.render_to_target(target);
     }
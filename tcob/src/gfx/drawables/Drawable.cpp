@@ -6,6 +6,7 @@
 #include "tcob/gfx/drawables/Drawable.hpp"
 
 #include "tcob/core/Interfaces.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 
 namespace tcob::gfx {
@@ -42,6 +43,20 @@ void drawable::draw_to(render_target& target)
     }
 }
 
+void drawable::submit_to(render_queue& queue, render_target& target, u8 layer)
+{
+    if (target.camera().VisibilityMask & VisibilityMask) {
+        if (is_visible() && !on_submit_to(queue, target, layer)) {
+            queue.submit(*this, layer);
+        }
+    }
+}
+
+auto drawable::on_submit_to(render_queue& /* queue */, render_target& /* target */, u8 /* layer */) -> bool
+{
+    return false;
+}
+
 void drawable::on_visibility_changed()
 {
 }
@@ -7,11 +7,11 @@
 
 #include <algorithm>
 #include <array>
+#include <cmath>
+#include <iterator>
 #include <limits>
 #include <memory>
-#include <mutex>
 #include <optional>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -25,7 +25,6 @@
 #include "tcob/gfx/Gfx.hpp"
 #include "tcob/gfx/Polygon.hpp"
 #include "tcob/gfx/Quadtree.hpp"
-#include "tcob/gfx/Ray.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 
 namespace tcob::gfx {
@@ -56,6 +55,7 @@ void lighting_system::remove_light_source(light_source const& light)
 
         return false;
     });
+    _staticSweeps.erase(&light);
 
     _isDirty = true;
 }
@@ -64,6 +64,7 @@ void lighting_system::clear_light_sources()
 {
     for (auto& ls : _lightSources) { ls->_parent = nullptr; }
     _lightSources.clear();
+    _staticSweeps.clear();
     _isDirty = true;
 }
 
@@ -74,9 +75,9 @@ void lighting_system::notify_light_changed(light_source* /* light */)
 
 void lighting_system::remove_shadow_caster(shadow_caster const& shadow)
 {
-    if (_quadTree && shadow._bounds != rect_f::Zero) {
-        _quadTree->remove({.Bounds = shadow._bounds, .Caster = &shadow});
-        mark_lights_dirty();
+    if (_staticTree && shadow._bounds != rect_f::Zero) {
+        remove_from_tree(shadow, shadow._bounds, shadow._isStatic);
+        mark_lights_dirty(shadow._bounds, shadow._isStatic);
     }
 
     helper::erase_first(_shadowCasters, [&shadow](auto const& val) {
@@ -97,28 +98,36 @@ void lighting_system::clear_shadow_casters()
     _shadowCasters.clear();
     _isDirty = true;
 
-    if (_quadTree) {
-        _quadTree->clear();
+    if (_staticTree) {
+        _staticTree->clear();
+        _dynamicTree->clear();
         mark_lights_dirty();
     }
 }
 
 void lighting_system::notify_shadow_changed(shadow_caster* shadow)
 {
-    mark_lights_dirty();
-    if (shadow->Polygon->empty()) {
-        _quadTree->remove({.Bounds = shadow->_bounds, .Caster = shadow});
-        shadow->_bounds = rect_f::Zero;
+    if (!_staticTree) { return; } // added once Bounds is set
+
+    // only lights overlapping the old or the new bounds need to recompute their visibility
+    rect_f const oldBounds {shadow->_bounds};
+    bool const   wasStatic {shadow->_isStatic};
+    if (oldBounds != rect_f::Zero) { mark_lights_dirty(oldBounds, wasStatic); }
+
+    shadow->_isStatic = shadow->Static;
+    shadow->_bounds   = shadow->Polygon->empty() ? rect_f::Zero : polygons::info(*shadow->Polygon).BoundingBox;
+
+    bool const hasBounds {shadow->_bounds != rect_f::Zero};
+    if (hasBounds) { mark_lights_dirty(shadow->_bounds, shadow->_isStatic); }
+
+    // moving dynamic casters stay in their tree and only get relinked if they left their node
+    if (oldBounds != rect_f::Zero && hasBounds && !wasStatic && !shadow->_isStatic) {
+        _dynamicTree->update(shadow->_treeHandle, {.Bounds = shadow->_bounds, .Caster = shadow});
         return;
     }
 
-    rect_f const newBounds {polygons::info(*shadow->Polygon).BoundingBox};
-    if (shadow->_bounds != rect_f::Zero) {
-        _quadTree->replace({.Bounds = shadow->_bounds, .Caster = shadow}, {.Bounds = newBounds, .Caster = shadow});
-    } else {
-        _quadTree->add({.Bounds = newBounds, .Caster = shadow});
-    }
-    shadow->_bounds = newBounds;
+    if (oldBounds != rect_f::Zero) { remove_from_tree(*shadow, oldBounds, wasStatic); }
+    if (hasBounds) { add_to_tree(*shadow); }
 }
 
 void lighting_system::set_blend_funcs(blend_funcs funcs)
@@ -132,132 +141,235 @@ void lighting_system::on_update(milliseconds /* deltaTime */)
 
     _store.clear();
 
-    // collect collision points
-    if (_quadTree) {
-        u32 indOffset {0};
+    if (_staticTree) {
+        _dirtyLights.clear();
+        for (auto const& ls : _lightSources) {
+            if (ls->_isDirty) { _dirtyLights.emplace_back(ls.get(), &_staticSweeps[ls.get()]); }
+        }
+
+        // lights are independent of each other, so their visibility polygons are computed in parallel
+        if (!_dirtyLights.empty()) {
+            auto& tm {locate_service<task_manager>()};
+            _sweepScratch.resize(static_cast<usize>(std::max<isize>(1, tm.thread_count())));
+
+            isize const lightCount {std::ssize(_dirtyLights)};
+            tm.run_parallel(
+                [&](par_task const& ctx) {
+                    auto& scratch {_sweepScratch[static_cast<usize>(ctx.Thread)]};
+                    for (isize i {ctx.Start}; i < ctx.End; ++i) {
+                        auto const& [light, cache] {_dirtyLights[static_cast<usize>(i)]};
+                        compute_visibility(*light, *cache, scratch);
+                    }
+                },
+                lightCount, _multiThreaded ? 1 : std::max<isize>(1, lightCount));
+        }
+
+        // raise the signals on the calling thread
+        for (auto const& [light, _] : _dirtyLights) {
+            for (auto const& collision : light->_collisionResult) {
+                if (collision.Caster) { collision.Caster->Hit(collision); }
+            }
+        }
+
+        _verts.clear();
+        _inds.clear();
         for (auto const& ls : _lightSources) {
-            auto const lightRange {ls->is_range_limited() ? **ls->Range : std::numeric_limits<f32>::max()};
-            cast_ray(*ls, lightRange);
-            build_geometry(*ls, lightRange, indOffset);
+            build_geometry(*ls, ls->is_range_limited() ? **ls->Range : std::numeric_limits<f32>::max());
         }
+        _store.set_vertices(0, _verts);
+        _store.set_indices(0, _inds);
     }
 
     _updateGeometry = true;
     _isDirty        = false;
 }
 
-constexpr f32 angleTolerance {0.05f}; // 0.0005f
+static auto cross(point_d a, point_d b) -> f64
+{
+    return (a.X * b.Y) - (a.Y * b.X);
+}
 
-static auto is_in_shadowcaster(light_source& light, auto const& casterPoints) -> bool
+// distance from the light to the segment along the given direction
+static auto ray_distance(point_d a, point_d b, point_d dir) -> f64
 {
-    for (usize i {0}; i < casterPoints.size() - 1; ++i) {
-        if (casterPoints[i].Points.empty()) { continue; }
-        if (polygons::is_point_inside(light.Position, casterPoints[i].Points)) { return true; }
-    }
-    return false;
+    point_d const edge {b - a};
+    f64 const     denom {cross(dir, edge)};
+    return std::abs(denom) < 1e-12 ? std::min(a.length(), b.length()) : cross(a, edge) / denom;
 }
 
-void lighting_system::cast_ray(light_source& light, f32 lightRange)
+void lighting_system::compute_visibility(light_source& light, static_sweep& cache, sweep_scratch& scratch) const
 {
-    if (!light._isDirty) { return; }
     light._isDirty = false;
 
     bool const   limitRange {light.is_range_limited()};
+    bool const   limitAngle {light.is_angle_limited()};
+    f64 const    lightRange {limitRange ? **light.Range : std::numeric_limits<f32>::max()};
     auto const   lightPosition {*light.Position};
-    rect_f const lightBounds {limitRange
-                                  ? rect_f {point_f::Zero, {lightRange * 2, lightRange * 2}}
-                                        .as_centered_at(lightPosition)
-                                        .as_intersection_with(*Bounds)
-                                  : *Bounds};
-
-    auto                              casters {_quadTree->query(lightBounds)};
-    std::vector<shadow_caster_points> casterPoints {};
-    casterPoints.reserve(casters.size());
-    for (auto const& caster : casters) {
-        casterPoints.push_back({.Points = *caster.Caster->Polygon, .Caster = caster.Caster});
+    rect_f const lightBounds {light_bounds(light)};
+
+    // every edge becomes a segment, oriented so the sweep (increasing angle) reaches A before B
+    auto const addPolyline {[&](polyline_span points, shadow_caster const* caster, auto& segments, auto& events, auto& active) {
+        usize const n {points.size()};
+        for (usize i {0}; i < n; ++i) {
+            point_d a {points[i] - lightPosition};
+            point_d b {points[(i + 1) % n] - lightPosition};
+
+            f64 const c {cross(a, b)};
+            if (std::abs(c) < 1e-9) { continue; } // collinear with the light, never visible
+            if (c < 0) { std::swap(a, b); }
+
+            u32 const index {static_cast<u32>(segments.size())};
+            f64 const startAngle {point_d::Zero.angle_to(a).Value};
+            f64 const endAngle {point_d::Zero.angle_to(b).Value};
+            segments.push_back({.A = a, .B = b, .Caster = caster});
+            events.push_back({.Angle = startAngle, .Segment = index, .Type = sweep_event_type::Start});
+            events.push_back({.Angle = endAngle, .Segment = index, .Type = sweep_event_type::End});
+
+            if (startAngle > endAngle) { active.push_back(index); } // crosses the 0 degree ray
+        }
+    }};
+
+    auto const addCaster {[&](quadtree_node const& caster, auto& segments, auto& events, auto& active, bool& lightInside) {
+        polyline_span const points {*caster.Caster->Polygon};
+        if (points.empty()) { return; }
+
+        addPolyline(points, caster.Caster, segments, events, active);
+        if (!lightInside && polygons::is_point_inside(lightPosition, points)) { lightInside = true; }
+    }};
+
+    auto const byAngle {[](sweep_event const& a, sweep_event const& b) { return a.Angle < b.Angle; }};
+
+    // static casters and the bounds only change when the light itself moves
+    if (light._isStaticDirty) {
+        light._isStaticDirty = false;
+        cache.Segments.clear();
+        cache.Events.clear();
+        cache.Active.clear();
+
+        cache.LightInside = false;
+        for (auto const& caster : _staticTree->query(lightBounds)) {
+            addCaster(caster, cache.Segments, cache.Events, cache.Active, cache.LightInside);
+        }
+
+        std::array<point_f, 4> const boundPoints {{Bounds->top_left(), Bounds->bottom_left(), Bounds->bottom_right(), Bounds->top_right()}};
+        addPolyline(boundPoints, nullptr, cache.Segments, cache.Events, cache.Active);
+
+        std::ranges::sort(cache.Events, byAngle);
     }
 
-    std::array<point_f, 4> const boundPoints {{Bounds->top_left(), Bounds->bottom_left(), Bounds->bottom_right(), Bounds->top_right()}};
-    casterPoints.emplace_back(boundPoints, nullptr);
-
-    bool const             lightInsideShadowCaster {is_in_shadowcaster(light, casterPoints)};
-    std::vector<f64> const angles {collect_angles(light, lightInsideShadowCaster, casterPoints)};
-
-    std::vector<std::pair<f64, light_collision>> collisionResult;
-    collisionResult.reserve(angles.size());
-    i32 const angleCount {static_cast<i32>(angles.size())};
-
-    // ray cast
-    locate_service<task_manager>().run_parallel(
-        [&](par_task const& ctx) {
-            std::vector<std::pair<f64, light_collision>> taskCollisionResult;
-            taskCollisionResult.reserve(ctx.End - ctx.Start);
-
-            for (isize idx {ctx.Start}; idx < ctx.End; ++idx) {
-                f64 const angle {angles[idx]};
-
-                light_collision nearestPoint;
-                nearestPoint.Distance = std::numeric_limits<f32>::max();
-                nearestPoint.Source   = &light;
-
-                for (auto const& cp : casterPoints) {
-                    ray const  ray {lightPosition, degree_d {angle}};
-                    auto const result {ray.intersect_polyline(cp.Points)};
-                    for (auto const& [point, distance] : result) {
-                        if (point == lightPosition) { continue; }
-                        if (distance >= nearestPoint.Distance) { continue; }
-
-                        if (limitRange && distance > lightRange) {
-                            // move out-of-range points into range
-                            point_d const direction {(point - lightPosition).as_normalized()};
-                            nearestPoint.Point    = lightPosition + direction * lightRange;
-                            nearestPoint.Distance = lightRange;
-                            nearestPoint.Caster   = nullptr;
-                        } else {
-                            nearestPoint.Point    = point;
-                            nearestPoint.Distance = distance;
-                            nearestPoint.Caster   = cp.Caster;
-                        }
-
-                        nearestPoint.CollisionCount = result.size();
-                    }
-                }
+    auto& segments {scratch.Segments};
+    auto& events {scratch.DynamicEvents};
+    auto& active {scratch.Active};
+    segments.assign(cache.Segments.begin(), cache.Segments.end());
+    active.assign(cache.Active.begin(), cache.Active.end());
+    events.clear();
 
-                if (nearestPoint.Distance == std::numeric_limits<f32>::max()) { continue; }
-                taskCollisionResult.emplace_back(angle, nearestPoint);
-            }
-            {
-                std::scoped_lock lock {_mutex};
-                collisionResult.insert(collisionResult.end(), taskCollisionResult.begin(), taskCollisionResult.end());
-            }
-        },
-        angleCount, _multiThreaded ? 64 : angleCount);
+    bool lightInsideShadowCaster {cache.LightInside};
+    _dynamicTree->query(lightBounds, [&](quadtree_node const& caster) {
+        addCaster(caster, segments, events, active, lightInsideShadowCaster);
+    });
+
+    // extra rays for the range circle and the angle limits
+    f64 const startLimit {limitAngle ? light.StartAngle->Value : 0.0};
+    f64 const endLimit {limitAngle ? light.EndAngle->Value : 360.0};
+    if (limitRange && !lightInsideShadowCaster) {
+        for (f64 i {startLimit}; i < endLimit; ++i) {
+            events.push_back({.Angle = degree_d {i}.as_normalized().Value});
+        }
+        if (limitAngle) { events.push_back({.Angle = light.EndAngle->as_normalized().Value}); }
+    } else if (limitAngle) {
+        events.push_back({.Angle = light.StartAngle->as_normalized().Value});
+        events.push_back({.Angle = light.EndAngle->as_normalized().Value});
+    }
+
+    std::ranges::sort(events, byAngle);
+
+    scratch.Events.clear();
+    std::ranges::merge(cache.Events, events, std::back_inserter(scratch.Events), byAngle);
+
+    auto& result {light._collisionResult};
+    result.clear();
+
+    auto const addNearest {[&](f64 angle) {
+        point_d const dir {point_d::FromDirection(degree_d {angle})};
+
+        f64                  nearest {std::numeric_limits<f64>::max()};
+        shadow_caster const* caster {nullptr};
+        for (u32 const idx : active) {
+            auto const& seg {segments[idx]};
+            f64 const   distance {ray_distance(seg.A, seg.B, dir)};
+            if (distance < 0 || distance >= nearest) { continue; }
+
+            nearest = distance;
+            caster  = seg.Caster;
+        }
+        if (nearest == std::numeric_limits<f64>::max()) { return; }
+
+        // how often the ray hits the nearest caster's outline
+        usize collisionCount {0};
+        for (u32 const idx : active) {
+            auto const& seg {segments[idx]};
+            if (seg.Caster == caster && ray_distance(seg.A, seg.B, dir) >= 0) { ++collisionCount; }
+        }
+
+        if (limitRange && nearest > lightRange) {
+            // move out-of-range points into range
+            nearest = lightRange;
+            caster  = nullptr;
+        }
+
+        light_collision const collision {.Point          = point_f {point_d {lightPosition} + dir * nearest},
+                                         .Distance       = nearest,
+                                         .CollisionCount = collisionCount,
+                                         .Source         = &light,
+                                         .Caster         = caster};
+
+        // discard close points
+        if (!result.empty() && result.back().Point.distance_to(collision.Point) < 1) { return; }
+        result.push_back(collision);
+    }};
 
-    std::ranges::sort(collisionResult, [](auto const& a, auto const& b) { return a.first > b.first; });
+    auto const& sweepEvents {scratch.Events};
 
-    // discard close points
-    light._collisionResult.clear();
-    light._collisionResult.reserve(collisionResult.size());
-    for (auto const& [k, v] : collisionResult) {
-        if (!light._collisionResult.empty() && light._collisionResult.back().Point.distance_to(v.Point) < 1) { continue; }
-        if (!lightInsideShadowCaster && (v.CollisionCount == 1 && v.Caster != nullptr)) { continue; }
+    // angular sweep: at every event the nearest active segment is sampled before and after the
+    // active set changes, which yields both points of a shadow edge at a caster corner
+    for (usize i {0}; i < sweepEvents.size();) {
+        f64 const angle {sweepEvents[i].Angle};
+        usize     j {i};
+        while (j < sweepEvents.size() && sweepEvents[j].Angle - angle < 1e-9) { ++j; }
+
+        bool const inRange {!limitAngle || (angle >= startLimit && angle <= endLimit)};
+        if (inRange) { addNearest(angle); }
+
+        for (usize k {i}; k < j; ++k) {
+            if (sweepEvents[k].Type == sweep_event_type::Start) { active.push_back(sweepEvents[k].Segment); }
+        }
+        for (usize k {i}; k < j; ++k) {
+            if (sweepEvents[k].Type != sweep_event_type::End) { continue; }
+            if (auto it {std::ranges::find(active, sweepEvents[k].Segment)}; it != active.end()) {
+                *it = active.back();
+                active.pop_back();
+            }
+        }
 
-        light._collisionResult.push_back(v);
-        if (v.Caster) { v.Caster->Hit(v); }
+        if (inRange) { addNearest(angle); }
+        i = j;
     }
+
+    // geometry is built clockwise
+    std::ranges::reverse(result);
 }
 
-void lighting_system::build_geometry(light_source& light, f32 lightRange, u32& indOffset)
+void lighting_system::build_geometry(light_source& light, f32 lightRange)
 {
-    std::vector<vertex> verts;
-    std::vector<u32>    inds;
-
     u32 const n {static_cast<u32>(light._collisionResult.size())};
     if (n <= 1) { return; }
 
-    verts.push_back({.Position  = light.Position,
-                     .Color     = light.Color,
-                     .TexCoords = {.U = 0, .V = 0, .Level = 0}});
+    u32 const indOffset {static_cast<u32>(_verts.size())};
+
+    _verts.push_back({.Position  = light.Position,
+                      .Color     = light.Color,
+                      .TexCoords = {.U = 0, .V = 0, .Level = 0}});
 
     bool const limitRange {light.is_range_limited()};
 
@@ -272,92 +384,84 @@ void lighting_system::build_geometry(light_source& light, f32 lightRange, u32& i
             col.A = static_cast<u8>(col.A * falloff);
         }
 
-        verts.push_back({.Position  = p.Point,
-                         .Color     = col,
-                         .TexCoords = {.U = 0, .V = 0, .Level = 0}});
+        _verts.push_back({.Position  = p.Point,
+                          .Color     = col,
+                          .TexCoords = {.U = 0, .V = 0, .Level = 0}});
     }
 
     for (u32 i {2}; i <= n; ++i) {
-        inds.push_back(0 + indOffset);
-        inds.push_back(i + indOffset);
-        inds.push_back(i - 1 + indOffset);
+        _inds.push_back(0 + indOffset);
+        _inds.push_back(i + indOffset);
+        _inds.push_back(i - 1 + indOffset);
     }
     if (!light.is_angle_limited()) {
-        inds.push_back(0 + indOffset);
-        inds.push_back(n + indOffset);
-        inds.push_back(1 + indOffset);
+        _inds.push_back(0 + indOffset);
+        _inds.push_back(n + indOffset);
+        _inds.push_back(1 + indOffset);
     }
-    indOffset += n + 1;
-
-    _store.set_vertices(0, verts);
-    _store.set_indices(0, inds);
 }
 
-auto lighting_system::collect_angles(light_source& light, bool lightInsideShadowCaster, std::vector<shadow_caster_points> const& casterPoints) const -> std::vector<f64>
+void lighting_system::rebuild_quadtree()
 {
-    auto const lightPosition {*light.Position};
-    bool const limitAngle {light.is_angle_limited()};
-
-    std::set<f64> angles;
-    std::array<f64, 3> constexpr vars {-angleTolerance, 0, angleTolerance};
-
-    for (auto const& cp : casterPoints) {
-        for (auto const& scp : cp.Points) {
-            auto const baseAngle {lightPosition.angle_to(scp).as_normalized().Value};
+    _staticTree  = std::make_unique<quadtree<quadtree_node>>(*Bounds);
+    _dynamicTree = std::make_unique<loose_quadtree<quadtree_node>>(*Bounds);
+    mark_lights_dirty();
 
-            if (!limitAngle || (baseAngle >= light.StartAngle->Value && baseAngle <= light.EndAngle->Value)) {
-                for (f64 var : vars) {
-                    angles.insert(degree_d {baseAngle + var}.as_normalized().Value);
-                }
-            }
-        }
+    for (auto& sc : _shadowCasters) {
+        sc->_isStatic = sc->Static;
+        sc->_bounds   = sc->Polygon->empty() ? rect_f::Zero : polygons::info(*sc->Polygon).BoundingBox;
+        if (sc->_bounds != rect_f::Zero) { add_to_tree(*sc); }
     }
+}
 
-    if (light.is_range_limited() && !lightInsideShadowCaster) {
-        f64 const start {limitAngle ? light.StartAngle->Value : 0.0};
-        f64 const end {limitAngle ? light.EndAngle->Value : 360.0};
-
-        for (f64 i {start}; i < end; ++i) {
-            angles.insert(i);
-        }
-    } else if (limitAngle) {
-        angles.insert(light.StartAngle->as_normalized().Value);
-        angles.insert(light.EndAngle->as_normalized().Value);
+void lighting_system::mark_lights_dirty()
+{
+    for (auto& light : _lightSources) {
+        light->_isDirty       = true;
+        light->_isStaticDirty = true;
     }
+    _isDirty = true;
+}
 
-    // filter and store angles with tolerance
-    std::vector<f64> retValue;
-    retValue.reserve(angles.size());
+void lighting_system::mark_lights_dirty(rect_f const& area, bool staticCasters)
+{
+    for (auto& light : _lightSources) {
+        if (!light_bounds(*light).intersects(area, true)) { continue; }
 
-    for (f64 const angle : angles) {
-        if (retValue.empty() || (angle - retValue.back() >= angleTolerance)) {
-            retValue.push_back(angle);
-        }
+        light->_isDirty = true;
+        if (staticCasters) { light->_isStaticDirty = true; }
+        _isDirty = true;
     }
-
-    return retValue;
 }
 
-void lighting_system::rebuild_quadtree()
+void lighting_system::add_to_tree(shadow_caster& shadow)
 {
-    if (_quadTree) {
-        _quadTree->clear();
-        mark_lights_dirty();
-        for (auto& sc : _shadowCasters) {
-            _quadTree->add(quadtree_node {.Bounds = polygons::info(*sc->Polygon).BoundingBox, .Caster = sc.get()});
-        }
+    if (shadow._isStatic) {
+        _staticTree->add({.Bounds = shadow._bounds, .Caster = &shadow});
     } else {
-        _quadTree = std::make_unique<quadtree<quadtree_node>>(*Bounds);
+        shadow._treeHandle = _dynamicTree->add({.Bounds = shadow._bounds, .Caster = &shadow});
     }
 }
 
-void lighting_system::mark_lights_dirty()
+void lighting_system::remove_from_tree(shadow_caster const& shadow, rect_f const& bounds, bool isStatic)
 {
-    for (auto& light : _lightSources) {
-        light->_isDirty = true;
+    if (isStatic) {
+        _staticTree->remove({.Bounds = bounds, .Caster = &shadow});
+    } else {
+        _dynamicTree->remove(shadow._treeHandle);
     }
 }
 
+auto lighting_system::light_bounds(light_source const& light) const -> rect_f
+{
+    if (!light.is_range_limited()) { return *Bounds; }
+
+    f32 const range {**light.Range};
+    return rect_f {point_f::Zero, {range * 2, range * 2}}
+        .as_centered_at(light.Position)
+        .as_intersection_with(*Bounds);
+}
+
 auto lighting_system::can_draw() const -> bool
 {
     return !_store.empty();
@@ -391,10 +495,15 @@ auto light_source::is_angle_limited() const -> bool
 light_source::light_source(lighting_system* parent)
     : _parent {parent}
 {
-    Color.Changed.connect([this](auto const&) { notify_parent(); });
+    // color and falloff only affect the geometry, not the visibility
+    Color.Changed.connect([this](auto const&) {
+        if (_parent) { _parent->notify_light_changed(this); }
+    });
+    Falloff.Changed.connect([this](auto const&) {
+        if (_parent) { _parent->notify_light_changed(this); }
+    });
     Position.Changed.connect([this](auto const&) { notify_parent(); });
     Range.Changed.connect([this](auto const&) { notify_parent(); });
-    Falloff.Changed.connect([this](auto const&) { notify_parent(); });
     StartAngle.Changed.connect([this](auto const&) { notify_parent(); });
     EndAngle.Changed.connect([this](auto const&) { notify_parent(); });
 }
@@ -404,13 +513,15 @@ void light_source::notify_parent()
     if (_parent) {
         _parent->notify_light_changed(this);
     }
-    _isDirty = true;
+    _isDirty       = true;
+    _isStaticDirty = true;
 }
 
 shadow_caster::shadow_caster(lighting_system* parent)
     : _parent {parent}
 {
     Polygon.Changed.connect([this](auto const&) { notify_parent(); });
+    Static.Changed.connect([this](auto const&) { notify_parent(); });
 }
 
 void shadow_caster::notify_parent()
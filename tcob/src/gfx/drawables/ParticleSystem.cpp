@@ -6,12 +6,23 @@
 #include "tcob/gfx/drawables/ParticleSystem.hpp"
 
 #include <chrono>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <vector>
 
 #include "tcob/core/AngleUnits.hpp"
 #include "tcob/core/Color.hpp"
+#include "tcob/core/Common.hpp"
 #include "tcob/core/Point.hpp"
+#include "tcob/core/ServiceLocator.hpp"
 #include "tcob/core/Size.hpp"
+#include "tcob/core/TaskManager.hpp"
 #include "tcob/gfx/Geometry.hpp"
+#include "tcob/gfx/Gfx.hpp"
+#include "tcob/gfx/Material.hpp"
+#include "tcob/gfx/RenderTarget.hpp"
+#include "tcob/gfx/Texture.hpp"
 
 namespace tcob::gfx {
 
@@ -19,6 +30,21 @@ using namespace std::chrono_literals;
 
 ////////////////////////////////////////////////////////////
 
+auto detail::particle_region_cache::get(pass const& pass, string const& name) -> texture_region
+{
+    if (!_handle.is_valid() || _name != name) {
+        _name   = name;
+        _handle = texture_region_handle {name};
+    }
+
+    if (pass.Texture) {
+        if (auto const* region {pass.Texture->regions().find(_handle)}) { return *region; }
+    }
+    return {};
+}
+
+////////////////////////////////////////////////////////////
+
 static void calc_velocity(auto&& particle, point_f pos, f32 seconds)
 {
     point_f const radial {pos * particle.RadialAcceleration};
@@ -142,35 +168,315 @@ void point_particle_emitter::emit(particle_system<point_particle_emitter>& syste
 {
     if (!is_alive()) { return; }
 
+    i32 const  particleCount {next_particle_count(deltaTime)};
+    auto const texRegion {_region.get(system.Material->first_pass(), Settings.Template.TextureRegion)}; // TODO texRegion pass
+
+    for (i32 i {0}; i < particleCount; ++i) {
+        init_particle(system.activate_particle(), texRegion);
+    }
+}
+
+void point_particle_emitter::emit(soa_point_particle_system& system, milliseconds deltaTime)
+{
+    if (!is_alive()) { return; }
+
+    i32 const  particleCount {next_particle_count(deltaTime)};
+    auto const texRegion {_region.get(system.Material->first_pass(), Settings.Template.TextureRegion)}; // TODO texRegion pass
+
+    auto& streams {system.streams()};
+    streams.reserve(streams.size() + particleCount);
+
+    point_particle particle;
+    for (i32 i {0}; i < particleCount; ++i) {
+        init_particle(particle, texRegion);
+        streams.push_back(particle);
+    }
+}
+
+auto point_particle_emitter::next_particle_count(milliseconds deltaTime) -> i32
+{
     _remainingLife -= deltaTime;
 
-    i32 particleCount {0};
     if (Settings.IsExplosion) {
-        particleCount = static_cast<i32>(Settings.SpawnRate);
-        _alive        = false;
-    } else {
-        f64 const particleAmount {(Settings.SpawnRate * (deltaTime.count() / 1000)) + _emissionDiff};
-        particleCount = static_cast<i32>(particleAmount);
-        _emissionDiff = particleAmount - particleCount;
+        _alive = false;
+        return static_cast<i32>(Settings.SpawnRate);
     }
 
-    auto const& tmpl {Settings.Template};
-    auto const& texRegion {system.Material->first_pass().Texture->regions()[tmpl.TextureRegion]}; // TODO texRegion pass
+    f64 const particleAmount {(Settings.SpawnRate * (deltaTime.count() / 1000)) + _emissionDiff};
+    i32 const particleCount {static_cast<i32>(particleAmount)};
+    _emissionDiff = particleAmount - particleCount;
+    return particleCount;
+}
 
-    for (i32 i {0}; i < particleCount; ++i) {
-        auto& particle {system.activate_particle()};
+void point_particle_emitter::init_particle(point_particle& particle, texture_region const& region)
+{
+    particle.Region = region;
 
-        particle.Region = texRegion;
+    setup_particle(particle, Settings.Template, _rng);
 
-        setup_particle(particle, tmpl, _rng);
+    // calculate random postion
+    f32 const x {_rng(Settings.SpawnArea.left(), Settings.SpawnArea.right())};
+    f32 const y {_rng(Settings.SpawnArea.top(), Settings.SpawnArea.bottom())};
 
-        // calculate random postion
-        f32 const x {_rng(Settings.SpawnArea.left(), Settings.SpawnArea.right())};
-        f32 const y {_rng(Settings.SpawnArea.top(), Settings.SpawnArea.bottom())};
+    // set position
+    particle.Position = {x, y};
+    particle.Origin   = particle.Position;
+}
+
+////////////////////////////////////////////////////////////
+
+auto point_particle_streams::size() const -> isize
+{
+    return std::ssize(RemainingLife);
+}
+
+auto point_particle_streams::empty() const -> bool
+{
+    return RemainingLife.empty();
+}
+
+void point_particle_streams::reserve(isize count)
+{
+    auto const cap {static_cast<usize>(count)};
+    PositionX.reserve(cap);
+    PositionY.reserve(cap);
+    OriginX.reserve(cap);
+    OriginY.reserve(cap);
+    VelocityX.reserve(cap);
+    VelocityY.reserve(cap);
+    AccelerationX.reserve(cap);
+    AccelerationY.reserve(cap);
+    LinearDamping.reserve(cap);
+    RadialAcceleration.reserve(cap);
+    TangentialAcceleration.reserve(cap);
+    RemainingLife.reserve(cap);
+    Color.reserve(cap);
+    TexCoords.reserve(cap);
+}
+
+void point_particle_streams::clear()
+{
+    PositionX.clear();
+    PositionY.clear();
+    OriginX.clear();
+    OriginY.clear();
+    VelocityX.clear();
+    VelocityY.clear();
+    AccelerationX.clear();
+    AccelerationY.clear();
+    LinearDamping.clear();
+    RadialAcceleration.clear();
+    TangentialAcceleration.clear();
+    RemainingLife.clear();
+    Color.clear();
+    TexCoords.clear();
+}
+
+void point_particle_streams::push_back(point_particle const& particle)
+{
+    PositionX.push_back(particle.Position.X);
+    PositionY.push_back(particle.Position.Y);
+    OriginX.push_back(particle.Origin.X);
+    OriginY.push_back(particle.Origin.Y);
+    VelocityX.push_back(particle.Velocity.X);
+    VelocityY.push_back(particle.Velocity.Y);
+    AccelerationX.push_back(particle.LinearAcceleration.X + particle.Gravity.X);
+    AccelerationY.push_back(particle.LinearAcceleration.Y + particle.Gravity.Y);
+    LinearDamping.push_back(particle.LinearDamping);
+    RadialAcceleration.push_back(particle.RadialAcceleration);
+    TangentialAcceleration.push_back(particle.TangentialAcceleration);
+    RemainingLife.push_back(static_cast<f32>(particle.RemainingLife.count()));
+    Color.push_back(particle.Color);
+    TexCoords.push_back({.U = particle.Region.UVRect.left(), .V = particle.Region.UVRect.top(), .Level = static_cast<f32>(particle.Region.Level)});
+}
+
+void point_particle_streams::swap_remove(isize index)
+{
+    auto const remove {[idx = static_cast<usize>(index)](auto& stream) {
+        stream[idx] = stream.back();
+        stream.pop_back();
+    }};
+
+    remove(PositionX);
+    remove(PositionY);
+    remove(OriginX);
+    remove(OriginY);
+    remove(VelocityX);
+    remove(VelocityY);
+    remove(AccelerationX);
+    remove(AccelerationY);
+    remove(LinearDamping);
+    remove(RadialAcceleration);
+    remove(TangentialAcceleration);
+    remove(RemainingLife);
+    remove(Color);
+    remove(TexCoords);
+}
+
+////////////////////////////////////////////////////////////
+
+// Updates the particles in [start, end), writes their vertices and collects the dead ones. The loops
+// only touch contiguous streams and avoid branches, so they are vectorized by the compiler.
+static void update_point_particles(point_particle_streams& particles, vertex* verts, std::vector<isize>& dead, isize start, isize end, milliseconds deltaTime)
+{
+    f32 const seconds {static_cast<f32>(deltaTime.count() / 1000)};
+    f32 const age {static_cast<f32>(std::abs(deltaTime.count()))};
+
+    f32* const       posX {particles.PositionX.data()};
+    f32* const       posY {particles.PositionY.data()};
+    f32* const       velX {particles.VelocityX.data()};
+    f32* const       velY {particles.VelocityY.data()};
+    f32 const* const orgX {particles.OriginX.data()};
+    f32 const* const orgY {particles.OriginY.data()};
+    f32 const* const accX {particles.AccelerationX.data()};
+    f32 const* const accY {particles.AccelerationY.data()};
+    f32 const* const damping {particles.LinearDamping.data()};
+    f32 const* const radial {particles.RadialAcceleration.data()};
+    f32 const* const tangential {particles.TangentialAcceleration.data()};
+    f32* const       life {particles.RemainingLife.data()};
+
+    // velocity
+    for (isize i {start}; i < end; ++i) {
+        f32 const dx {posX[i] - orgX[i]};
+        f32 const dy {posY[i] - orgY[i]};
+        f32 const len2 {(dx * dx) + (dy * dy)};
+        f32 const inv {1.0f / std::sqrt(len2 + std::numeric_limits<f32>::min())}; // no branch, a zero offset stays zero
+        f32 const nx {dx * inv};
+        f32 const ny {dy * inv};
+
+        f32 const ax {(nx * radial[i]) - (ny * tangential[i]) + accX[i]};
+        f32 const ay {(ny * radial[i]) + (nx * tangential[i]) + accY[i]};
+        f32 const damp {1.0f / (1.0f + (damping[i] * seconds))};
+
+        velX[i] = (velX[i] + (ax * seconds)) * damp;
+        velY[i] = (velY[i] + (ay * seconds)) * damp;
+    }
+
+    // position and age
+    for (isize i {start}; i < end; ++i) {
+        posX[i] += velX[i] * seconds;
+        posY[i] += velY[i] * seconds;
+        life[i] -= age;
+    }
+
+    // vertices
+    color const* const col {particles.Color.data()};
+    uv const* const    tex {particles.TexCoords.data()};
+    for (isize i {start}; i < end; ++i) {
+        verts[i] = {.Position = {posX[i], posY[i]}, .Color = col[i], .TexCoords = tex[i]};
+    }
+
+    for (isize i {start}; i < end; ++i) {
+        if (life[i] <= 0.0f) { dead.push_back(i); }
+    }
+}
+
+soa_point_particle_system::soa_point_particle_system(bool multiThreaded, isize reservedParticleCount)
+    : _multiThreaded {multiThreaded}
+{
+    if (reservedParticleCount > 0) {
+        _particles.reserve(reservedParticleCount);
+        _vertices.reserve(static_cast<usize>(reservedParticleCount));
+    }
+}
+
+auto soa_point_particle_system::is_running() const -> bool
+{
+    return _isRunning;
+}
+
+void soa_point_particle_system::start()
+{
+    if (_isRunning) { return; }
+
+    _isRunning = true;
+    for (auto& emitter : _emitters) { emitter->reset(); }
+
+    _particles.clear();
+}
+
+void soa_point_particle_system::restart()
+{
+    stop();
+    start();
+}
+
+void soa_point_particle_system::stop()
+{
+    _isRunning = false;
+
+    _renderer.reset_geometry();
+    _particles.clear();
+    _vertices.clear();
+}
+
+void soa_point_particle_system::remove_emitter(point_particle_emitter const& emitter)
+{
+    helper::erase_first(_emitters, [&emitter](auto const& val) { return val.get() == &emitter; });
+}
+
+void soa_point_particle_system::clear_emitters()
+{
+    _emitters.clear();
+    stop();
+}
+
+auto soa_point_particle_system::particle_count() const -> isize
+{
+    return _particles.size();
+}
+
+auto soa_point_particle_system::streams() -> point_particle_streams&
+{
+    return _particles;
+}
+
+auto soa_point_particle_system::streams() const -> point_particle_streams const&
+{
+    return _particles;
+}
+
+void soa_point_particle_system::on_update(milliseconds deltaTime)
+{
+    if (!_isRunning || !Material) { return; }
+
+    for (auto& emitter : _emitters) {
+        emitter->emit(*this, deltaTime);
+    }
+
+    isize const count {_particles.size()};
+    _vertices.resize(static_cast<usize>(count));
+    if (count == 0) { return; }
+
+    auto& tm {locate_service<task_manager>()};
+    _deadParticles.resize(static_cast<usize>(std::max<isize>(1, tm.thread_count())));
+
+    tm.run_parallel(
+        [&](par_task const& ctx) {
+            update_point_particles(_particles, _vertices.data(), _deadParticles[static_cast<usize>(ctx.Thread)].Indices, ctx.Start, ctx.End, deltaTime);
+        },
+        count, _multiThreaded ? 1024 : count);
+
+    // remove dead particles, their vertices are replaced like the streams
+    detail::drain_kill_lists(_deadParticles, [this](isize i) {
+        _vertices[static_cast<usize>(i)] = _vertices.back();
+        _vertices.pop_back();
+        _particles.swap_remove(i);
+    });
+}
+
+auto soa_point_particle_system::can_draw() const -> bool
+{
+    return _isRunning && !_particles.empty() && !(*Material).is_expired();
+}
+
+void soa_point_particle_system::on_draw_to(render_target& target)
+{
+    for (isize i {0}; i < Material->pass_count(); ++i) {
+        auto const& pass {Material->get_pass(i)};
 
-        // set position
-        particle.Position = {x, y};
-        particle.Origin   = particle.Position;
+        _renderer.set_geometry(_vertices, &pass);
+        _renderer.render_to_target(target);
     }
 }
 
@@ -204,7 +510,7 @@ void quad_particle_emitter::emit(particle_system<quad_particle_emitter>& system,
     }
 
     auto const& tmpl {Settings.Template};
-    auto const& texRegion {system.Material->first_pass().Texture->regions()[tmpl.TextureRegion]}; // TODO texRegion pass
+    auto const  texRegion {_region.get(system.Material->first_pass(), tmpl.TextureRegion)}; // TODO texRegion pass
 
     for (i32 i {0}; i < particleCount; ++i) {
         auto& particle {system.activate_particle()};
@@ -11,6 +11,7 @@
 #include <iterator>
 #include <limits>
 #include <memory>
+#include <optional>
 #include <span>
 #include <unordered_map>
 #include <utility>
@@ -36,12 +37,32 @@ shape_batch::shape_batch()
 
 void shape_batch::remove_shape(shape const& shape)
 {
-    helper::erase_first(_children, [&shape](auto const& val) { return val.get() == &shape; });
+    auto it {std::ranges::find_if(_children, [&shape](auto const& val) { return val.get() == &shape; })};
+    if (it == _children.end()) { return; }
+
+    _index.remove(shape._batchHandle);
+    ++_indexChanges;
+    for (u32 const slot : shape._batchSlots) { _renderer.remove_geometry(slot); }
+    std::erase(_dirtyShapes, &shape);
+    std::erase(_pendingShapes, &shape);
+    _children.erase(it);
 }
 
 void shape_batch::clear()
 {
     _children.clear();
+    _index.clear();
+    _indexChanges = 0;
+    _renderer.reset_geometry();
+    _dirtyShapes.clear();
+    _pendingShapes.clear();
+    _layoutDirty = false;
+}
+
+void shape_batch::rebuild_index()
+{
+    _index.rebuild();
+    _indexChanges = 0;
 }
 
 void shape_batch::bring_to_front(shape const& shape)
@@ -49,6 +70,7 @@ void shape_batch::bring_to_front(shape const& shape)
     auto it {std::ranges::find_if(_children, [&shape](auto const& val) { return val.get() == &shape; })};
     if (it != _children.end()) {
         std::rotate(it, it + 1, _children.end());
+        _layoutDirty = true;
     }
 }
 
@@ -57,6 +79,7 @@ void shape_batch::send_to_back(shape const& shape)
     auto it {std::ranges::find_if(_children, [&shape](auto const& val) { return val.get() == &shape; })};
     if (it != _children.end()) {
         std::rotate(_children.begin(), it, it + 1);
+        _layoutDirty = true;
     }
 }
 
@@ -78,37 +101,61 @@ auto shape_batch::get_shape_at(isize index) const -> shape&
 auto shape_batch::intersect(ray const& ray, u32 mask) const -> std::unordered_map<shape*, std::vector<ray::result>>
 {
     std::unordered_map<shape*, std::vector<ray::result>> retValue;
-    for (auto const& child : _children) {
+    _index.raycast(ray, [&](shape* child, f64 maxDistance) {
         if (child->IntersectMask & mask) {
             auto points {child->intersect(ray)};
-            if (points.empty()) { continue; }
-            retValue.emplace(child.get(), std::move(points));
+            if (!points.empty()) { retValue.emplace(child, std::move(points)); }
         }
-    }
+        return maxDistance;
+    });
     return retValue;
 }
 
-auto shape_batch::intersect(rect_f const& rect, u32 mask) const -> std::vector<shape*>
+auto shape_batch::intersect_first(ray const& ray, u32 mask) const -> std::optional<std::pair<shape*, ray::result>>
 {
-    std::vector<shape*> retValue;
-    for (auto const& child : _children) {
-        if (child->IntersectMask & mask) {
-            if (child->aabb().intersects(rect, true)) {
-                retValue.push_back(child.get());
+    // the shrinking max distance prunes every shape behind the nearest hit so far
+    std::optional<std::pair<shape*, ray::result>> retValue;
+    _index.raycast(ray, [&](shape* child, f64 maxDistance) {
+        if (!(child->IntersectMask & mask)) { return maxDistance; }
+
+        for (auto const& hit : child->intersect(ray)) {
+            if (hit.Distance < maxDistance) {
+                maxDistance = hit.Distance;
+                retValue    = {child, hit};
             }
         }
-    }
+        return maxDistance;
+    });
+    return retValue;
+}
+
+auto shape_batch::intersect(rect_f const& rect, u32 mask) const -> std::vector<shape*>
+{
+    std::vector<shape*> retValue;
+    _index.query(rect, [&](shape* child) {
+        if (child->IntersectMask & mask) { retValue.push_back(child); }
+    });
     return retValue;
 }
 
 void shape_batch::on_update(milliseconds deltaTime)
 {
-    _isDirty = false;
     for (auto& child : _children) {
-        if (child->is_dirty()) { _isDirty = true; }
-
+        bool const childDirty {child->is_dirty()};
         child->update(deltaTime);
+
+        // transform changes mark the shape dirty, its bounds are current after the update
+        if (childDirty) { _index.update(child->_batchHandle, child->aabb()); }
+        // the list is only drained when the batch is drawn, a shape is queued at most once
+        if ((childDirty || child->_isGeometryChanged) && !child->_batchQueued) {
+            child->_batchQueued = true;
+            _dirtyShapes.push_back(child.get());
+        }
+        child->_isGeometryChanged = false;
     }
+
+    // insertions stay balanced but not tight, and new shapes go in before their bounds are known
+    if (_indexChanges > _index.size() / 2) { rebuild_index(); }
 }
 
 auto shape_batch::can_draw() const -> bool
@@ -118,51 +165,88 @@ auto shape_batch::can_draw() const -> bool
 
 void shape_batch::on_draw_to(render_target& target)
 {
-    if (_isDirty) {
-        _isDirty = false;
-
-        _renderer.reset_geometry();
+    // dirty shapes are rewritten in place, as long as their slots keep size and pass
+    for (auto* shape : _dirtyShapes) {
+        shape->_batchQueued = false;
+        if (_layoutDirty || shape->_batchPending) { continue; }
 
-        isize maxPasses {0};
-        for (auto& shape : _children) {
-            maxPasses = std::max(maxPasses, shape->Material->pass_count());
+        bool const visible {shape->is_visible()};
+        if (visible != !shape->_batchSlots.empty() || (visible && !update_geometry(*shape))) {
+            _layoutDirty = true;
         }
-
-        for (auto& shape : _children) {
-            if (shape->is_visible()) {
-                for (isize p {0}; p < maxPasses; ++p) {
-                    if (p >= shape->Material->pass_count()) { continue; }
-
-                    auto const& pass {shape->Material->get_pass(p)};
-                    _renderer.add_geometry(shape->geometry(p), &pass);
-                }
-            }
+    }
+    _dirtyShapes.clear();
+
+    if (_layoutDirty) {
+        rebuild_geometry();
+    } else {
+        // new shapes are always last in draw order
+        for (auto* shape : _pendingShapes) {
+            shape->_batchPending = false;
+            if (shape->is_visible()) { add_geometry(*shape); }
         }
     }
+    _pendingShapes.clear();
 
     _renderer.render_to_target(target);
 }
 
+void shape_batch::rebuild_geometry()
+{
+    _renderer.reset_geometry();
+    for (auto& shape : _children) {
+        shape->_batchSlots.clear();
+        shape->_batchPending = false;
+        if (shape->is_visible()) { add_geometry(*shape); }
+    }
+    _layoutDirty = false;
+}
+
+void shape_batch::add_geometry(shape& shape)
+{
+    for (isize p {0}; p < shape.Material->pass_count(); ++p) {
+        auto const& pass {shape.Material->get_pass(p)};
+        shape._batchSlots.push_back(_renderer.add_geometry(shape.geometry(p), &pass));
+    }
+}
+
+auto shape_batch::update_geometry(shape& shape) -> bool
+{
+    if (std::ssize(shape._batchSlots) != shape.Material->pass_count()) { return false; }
+
+    for (isize p {0}; p < shape.Material->pass_count(); ++p) {
+        auto const& pass {shape.Material->get_pass(p)};
+        if (!_renderer.update_geometry(shape._batchSlots[static_cast<usize>(p)], shape.geometry(p), &pass)) { return false; }
+    }
+    return true;
+}
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
 shape::shape()
+    : _textureRegion {*TextureRegion}
 {
     Pivot.Changed.connect([this](auto const&) { mark_dirty(); });
 
     Material.Changed.connect([this] { TextureRegion("default"); });
-    TextureRegion.Changed.connect([this] { mark_dirty(); });
+    TextureRegion.Changed.connect([this](auto const& value) {
+        _textureRegion = texture_region_handle {value};
+        mark_dirty();
+    });
     Color.Changed.connect([this] { mark_dirty(); });
 }
 
 void shape::show()
 {
     _visible = true;
+    mark_dirty();
 }
 
 void shape::hide()
 {
     _visible = false;
+    mark_dirty();
 }
 
 auto shape::is_visible() const -> bool
@@ -190,10 +274,15 @@ void shape::mark_clean()
     _isDirty = false;
 }
 
+void shape::mark_geometry_changed()
+{
+    _isGeometryChanged = true;
+}
+
 auto shape::get_texture_region(pass const& pass) const -> texture_region
 {
-    if (pass.Texture && pass.Texture->regions().contains(TextureRegion)) {
-        return pass.Texture->regions()[TextureRegion];
+    if (pass.Texture) {
+        if (auto const* region {pass.Texture->regions().find(_textureRegion)}) { return *region; }
     }
 
     return {.UVRect = {0, 0, 1, 1}, .Level = 0};
@@ -267,6 +356,7 @@ void rect_shape::on_update(milliseconds deltaTime)
         for (auto& kvp : _quads) {
             geometry::scroll_texcoords(kvp.second, *TextureScroll * (deltaTime.count() / 1000.0f));
         }
+        mark_geometry_changed();
     }
 }
 
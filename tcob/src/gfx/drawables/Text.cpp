@@ -13,6 +13,7 @@
 #include "tcob/core/assets/Asset.hpp"
 #include "tcob/gfx/Font.hpp"
 #include "tcob/gfx/Geometry.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 #include "tcob/gfx/TextFormatter.hpp"
 
@@ -49,6 +50,12 @@ void text::on_draw_to(render_target& target)
     _renderer.render_to_target(target);
 }
 
+auto text::on_submit_to(render_queue& queue, render_target& /* target */, u8 layer) -> bool
+{
+    queue.submit(_quads, *_material, 0, layer);
+    return true;
+}
+
 auto text::pivot() const -> point_f
 {
     if ((*Pivot).has_value()) {
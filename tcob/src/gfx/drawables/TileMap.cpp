@@ -7,7 +7,9 @@
 
 #include <algorithm>
 #include <cassert>
+#include <limits>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "tcob/core/Common.hpp"
@@ -15,6 +17,7 @@
 #include "tcob/core/Rect.hpp"
 #include "tcob/core/Size.hpp"
 #include "tcob/gfx/Gfx.hpp"
+#include "tcob/gfx/RenderQueue.hpp"
 #include "tcob/gfx/RenderTarget.hpp"
 
 namespace tcob::gfx {
@@ -48,7 +51,6 @@ static auto IndexToPosition(i32 i, render_direction direction, size_i layerSize)
 ////////////////////////////////////////////////////////////
 
 tilemap_base::tilemap_base()
-    : _renderer {buffer_usage_hint::DynamicDraw}
 {
     Material.Changed.connect([this](auto const&) { mark_dirty(); });
     Position.Changed.connect([this](auto const&) { mark_dirty(); });
@@ -56,22 +58,26 @@ tilemap_base::tilemap_base()
 
 auto tilemap_base::create_layer() -> tilemap_layer&
 {
-    mark_dirty();
+    _isVisibleDirty = true;
     return *_layers.emplace_back(std::unique_ptr<tilemap_layer>(new tilemap_layer {this}));
 }
 
 void tilemap_base::remove_layer(tilemap_layer const& layer)
 {
+    _chunks.erase(&layer);
+    _isLayoutDirty = true;
     helper::erase_first(_layers, [&layer](auto const& val) {
         return static_cast<bool>(val.get() == &layer);
     });
 
-    mark_dirty();
+    _isVisibleDirty = true;
 }
 
 void tilemap_base::clear()
 {
     _layers.clear();
+    _chunks.clear();
+    _isLayoutDirty = true;
     mark_dirty();
 }
 
@@ -81,7 +87,7 @@ void tilemap_base::bring_to_front(tilemap_layer const& layer)
     if (it != _layers.end()) {
         std::rotate(it, it + 1, _layers.end());
     }
-    mark_dirty();
+    _isVisibleDirty = true;
 }
 
 void tilemap_base::send_to_back(tilemap_layer const& layer)
@@ -90,33 +96,229 @@ void tilemap_base::send_to_back(tilemap_layer const& layer)
     if (it != _layers.end()) {
         std::rotate(_layers.begin(), it, it + 1);
     }
-    mark_dirty();
+    _isVisibleDirty = true;
 }
 
-void tilemap_base::notify_layer_changed(tilemap_layer* /* layer */)
+void tilemap_base::notify_layer_changed(tilemap_layer* layer)
 {
-    mark_dirty();
+    _chunks.erase(layer);
+    _isLayoutDirty  = true;
+    _isVisibleDirty = true;
+}
+
+void tilemap_base::notify_layer_visibility_changed()
+{
+    _isVisibleDirty = true;
+}
+
+void tilemap_base::notify_tile_changed(tilemap_layer* layer, point_i pos)
+{
+    auto it {_chunks.find(layer)};
+    if (it == _chunks.end()) { return; } // layer not built yet
+
+    point_i const chunkPos {pos.X / ChunkSize, pos.Y / ChunkSize};
+    if (!rect_i {point_i::Zero, it->second.size()}.contains(chunkPos)) { return; }
+
+    it->second[chunkPos].Dirty = true;
 }
 
 void tilemap_base::on_update(milliseconds /* deltaTime */)
 {
     if (_layers.empty() || !Material) { return; }
-    if (!_isDirty) { return; }
 
-    _quads.clear();
-    _isDirty = false;
+    if (_isDirty) {
+        _chunks.clear();
+        _isDirty        = false;
+        _isLayoutDirty  = true;
+        _isVisibleDirty = true;
+    }
+
+    for (auto const& layer : _layers) {
+        if (!layer->Visible) { continue; }
+
+        auto& chunks {_chunks[layer.get()]};
+        if (chunks.count() == 0) {
+            create_chunks(*layer, chunks);
+            _isLayoutDirty = true;
+        }
+
+        for (auto& chunk : chunks) {
+            if (!chunk.Dirty) { continue; }
+            build_chunk(*layer, chunk);
+            _isUploadDirty  = true;
+            _isVisibleDirty = true;
+        }
+    }
+}
+
+void tilemap_base::create_chunks(tilemap_layer const& layer, grid<chunk>& chunks) const
+{
+    auto const& tiles {*layer.Tiles};
+    chunks = grid<chunk> {size_i {(tiles.width() + ChunkSize - 1) / ChunkSize, (tiles.height() + ChunkSize - 1) / ChunkSize}};
+
+    for (i32 y {0}; y < chunks.height(); ++y) {
+        for (i32 x {0}; x < chunks.width(); ++x) {
+            point_i const pos {x * ChunkSize, y * ChunkSize};
+            chunks[x, y].Tiles = {pos, {std::min(ChunkSize, tiles.width() - pos.X), std::min(ChunkSize, tiles.height() - pos.Y)}};
+        }
+    }
+}
+
+void tilemap_base::build_chunk(tilemap_layer const& layer, chunk& chunk) const
+{
+    auto const& tiles {*layer.Tiles};
+    isize const passCount {Material->pass_count()};
+
+    chunk.Quads.resize(static_cast<usize>(passCount));
+    for (auto& quads : chunk.Quads) { quads.clear(); }
+    chunk.RowStarts.assign(static_cast<usize>(chunk.Tiles.height() + 1), 0);
+
+    for (i32 i {0}; i < chunk.Tiles.width() * chunk.Tiles.height(); ++i) {
+        if (i % chunk.Tiles.width() == 0 && passCount > 0) {
+            chunk.RowStarts[static_cast<usize>(i / chunk.Tiles.width())] = static_cast<u32>(chunk.Quads[0].size());
+        }
+
+        point_i const      tilePos {chunk.Tiles.top_left() + IndexToPosition(i, layer.RenderDirection, chunk.Tiles.Size)};
+        tile_index_t const idx {tiles[tilePos]};
+        if (idx == 0) { continue; }
+
+        for (isize p {0}; p < passCount; ++p) {
+            setup_quad(Material->get_pass(p), chunk.Quads[static_cast<usize>(p)].emplace_back(), tilePos + *layer.Offset, idx);
+        }
+    }
+
+    chunk.Bounds   = rect_f::Zero;
+    chunk.Dirty    = false;
+    chunk.Uploaded = false;
+    if (chunk.Quads.empty() || chunk.Quads[0].empty()) { return; }
+    chunk.RowStarts.back() = static_cast<u32>(chunk.Quads[0].size());
+
+    // every pass shares the same positions
+    f32 left {std::numeric_limits<f32>::max()}, top {std::numeric_limits<f32>::max()};
+    f32 right {std::numeric_limits<f32>::lowest()}, bottom {std::numeric_limits<f32>::lowest()};
+    for (auto const& q : chunk.Quads[0]) {
+        for (auto const& vert : q) {
+            left   = std::min(left, vert.Position.X);
+            top    = std::min(top, vert.Position.Y);
+            right  = std::max(right, vert.Position.X);
+            bottom = std::max(bottom, vert.Position.Y);
+        }
+    }
+    chunk.Bounds = rect_f::FromLTRB(left, top, right, bottom);
+}
+
+void tilemap_base::collect_visible_chunks(rect_f const& viewport)
+{
+    std::vector<chunk const*> visibleChunks;
+    visibleChunks.reserve(_visibleChunks.size());
+    std::vector<usize> rowEnds; // end of each chunk row in visibleChunks
 
     for (auto const& layer : _layers) {
         if (!layer->Visible) { continue; }
 
-        auto const& tiles {*layer->Tiles};
-        for (i32 i {0}; i < tiles.width() * tiles.height(); ++i) {
-            auto const tilePos {IndexToPosition(i, layer->RenderDirection, tiles.size())};
-            for (isize p {0}; p < Material->pass_count(); ++p) {
-                setup_quad(Material->get_pass(p), _quads[p].emplace_back(), tilePos + *layer->Offset, tiles[tilePos]);
+        auto it {_chunks.find(layer.get())};
+        if (it == _chunks.end()) { continue; }
+
+        // chunk rows and columns follow the layer's render direction
+        auto const& chunks {it->second};
+        for (i32 i {0}; i < chunks.count(); ++i) {
+            auto const& chunk {chunks[IndexToPosition(i, layer->RenderDirection, chunks.size())]};
+            if (!chunk.Quads.empty() && !chunk.Quads[0].empty() && chunk.Bounds.intersects(viewport, true)) {
+                visibleChunks.push_back(&chunk);
+            }
+
+            bool const rowEnd {(i + 1) % chunks.width() == 0};
+            if (rowEnd && visibleChunks.size() > (rowEnds.empty() ? 0 : rowEnds.back())) {
+                rowEnds.push_back(visibleChunks.size());
             }
         }
     }
+
+    // only rebuild the draw order if the set of visible chunks changed
+    if (!_isVisibleDirty && visibleChunks == _visibleChunks) { return; }
+
+    _visibleChunks  = std::move(visibleChunks);
+    _isVisibleDirty = false;
+    _isOrderDirty   = true;
+
+    // Overlapping tiles (isometric, hexagonal) need the same order as an unchunked layer:
+    // every tile row of a chunk row, each across all visible chunks of that row.
+    _visibleSegments.clear();
+    auto const addRows {[this](std::span<chunk const* const> row) {
+        for (usize k {0}; k + 1 < row.front()->RowStarts.size(); ++k) {
+            for (auto const* chunk : row) {
+                u32 const first {chunk->RowStarts[k]};
+                u32 const count {chunk->RowStarts[k + 1] - first};
+                if (count == 0) { continue; }
+
+                if (!_visibleSegments.empty()) {
+                    auto& last {_visibleSegments.back()};
+                    if (last.Chunk == chunk && last.First + last.Count == first) {
+                        last.Count += count;
+                        continue;
+                    }
+                }
+                _visibleSegments.push_back({.Chunk = chunk, .First = first, .Count = count});
+            }
+        }
+    }};
+
+    usize rowStart {0};
+    for (usize const rowEnd : rowEnds) {
+        addRows(std::span {_visibleChunks}.subspan(rowStart, rowEnd - rowStart));
+        rowStart = rowEnd;
+    }
+}
+
+void tilemap_base::upload_chunks()
+{
+    isize const passCount {Material->pass_count()};
+
+    if (_isLayoutDirty || std::ssize(_renderers) != passCount) {
+        // every chunk gets room for all of its tiles, so rebuilding one never moves another
+        u32 quadCount {0};
+        for (auto& [_, chunks] : _chunks) {
+            for (auto& chunk : chunks) {
+                chunk.QuadOffset = quadCount;
+                chunk.Uploaded   = false;
+                quadCount += static_cast<u32>(chunk.Tiles.width() * chunk.Tiles.height());
+            }
+        }
+
+        _renderers.resize(static_cast<usize>(passCount));
+        for (auto& renderer : _renderers) {
+            if (!renderer) { renderer = std::make_unique<indexed_quad_renderer>(buffer_usage_hint::DynamicDraw); }
+            renderer->resize(quadCount);
+        }
+
+        _isLayoutDirty = false;
+        _isUploadDirty = true;
+        _isOrderDirty  = true;
+    }
+
+    if (_isUploadDirty) {
+        for (auto& [_, chunks] : _chunks) {
+            for (auto& chunk : chunks) {
+                if (chunk.Uploaded) { continue; }
+                for (usize p {0}; p < chunk.Quads.size(); ++p) {
+                    _renderers[p]->update_geometry(chunk.Quads[p], chunk.QuadOffset);
+                }
+                chunk.Uploaded = true;
+            }
+        }
+        _isUploadDirty = false;
+    }
+
+    if (_isOrderDirty) {
+        _drawOrder.clear();
+        for (auto const& seg : _visibleSegments) {
+            for (u32 q {0}; q < seg.Count; ++q) {
+                _drawOrder.push_back(seg.Chunk->QuadOffset + seg.First + q);
+            }
+        }
+        for (auto& renderer : _renderers) { renderer->set_order(_drawOrder); }
+        _isOrderDirty = false;
+    }
 }
 
 auto tilemap_base::can_draw() const -> bool
@@ -124,14 +326,37 @@ auto tilemap_base::can_draw() const -> bool
     return !_layers.empty() && !(*Material).is_expired();
 }
 
+void tilemap_base::update_visible_chunks(render_target& target)
+{
+    rect_f const viewport {target.camera().transformed_viewport()};
+    if (_isVisibleDirty || viewport != _visibleViewport) {
+        _visibleViewport = viewport;
+        collect_visible_chunks(viewport);
+    }
+}
+
 void tilemap_base::on_draw_to(render_target& target)
 {
+    update_visible_chunks(target);
+    upload_chunks();
+
     for (isize p {0}; p < Material->pass_count(); ++p) {
-        auto const& pass {Material->get_pass(p)};
+        auto& renderer {*_renderers[static_cast<usize>(p)]};
+        renderer.set_pass(&Material->get_pass(p));
+        renderer.render_to_target(target);
+    }
+}
 
-        _renderer.set_geometry(_quads[p], &pass);
-        _renderer.render_to_target(target);
+auto tilemap_base::on_submit_to(render_queue& queue, render_target& target, u8 layer) -> bool
+{
+    update_visible_chunks(target);
+
+    for (isize p {0}; p < Material->pass_count(); ++p) {
+        for (auto const& seg : _visibleSegments) {
+            queue.submit(std::span {seg.Chunk->Quads[static_cast<usize>(p)]}.subspan(seg.First, seg.Count), **Material, p, layer);
+        }
     }
+    return true;
 }
 
 void tilemap_base::mark_dirty()
@@ -142,13 +367,28 @@ void tilemap_base::mark_dirty()
 ////////////////////////////////////////////////////////////
 
 tilemap_layer::tilemap_layer(tilemap_base* parent)
+    : _parent {parent}
 {
     Tiles.Changed.connect([this, parent](auto const&) { parent->notify_layer_changed(this); });
     Offset.Changed.connect([this, parent](auto const&) { parent->notify_layer_changed(this); });
-    Visible.Changed.connect([this, parent](auto const&) { parent->notify_layer_changed(this); });
+    Visible.Changed.connect([parent](auto const&) { parent->notify_layer_visibility_changed(); });
     RenderDirection.Changed.connect([this, parent](auto const&) { parent->notify_layer_changed(this); });
 }
 
+auto tilemap_layer::get_tile(point_i pos) const -> tile_index_t
+{
+    return (*Tiles)[pos];
+}
+
+void tilemap_layer::set_tile(point_i pos, tile_index_t idx)
+{
+    Tiles.mutate([&](auto& tiles) {
+        tiles[pos] = idx;
+        return false; // no Changed signal, only the affected chunk gets rebuilt
+    });
+    _parent->notify_tile_changed(this, pos);
+}
+
 ////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////
 
@@ -5,8 +5,12 @@
 
 #include "B2D.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <cstdint>
+#include <memory>
 #include <span>
+#include <thread>
 #include <vector>
 
 #include <box2d/base.h>
@@ -64,25 +68,125 @@ b2d_world::b2d_world(world::settings const& settings)
     worldDef.enableSleep          = settings.EnableSleeping;
     worldDef.enableContinuous     = settings.EnableContinuous;
 
-    worldDef.workerCount = static_cast<i32>(locate_service<task_manager>().thread_count());
-    worldDef.enqueueTask = [](b2TaskCallback* task, int32_t itemCount, int32_t minRange, void* taskContext, void* /* userContext */) -> void* {
-        locate_service<task_manager>().run_parallel(
-            [task, taskContext](par_task const& ctx) {
-                task(static_cast<i32>(ctx.Start), static_cast<i32>(ctx.End), static_cast<i32>(ctx.Thread), taskContext);
-            },
-            itemCount, minRange);
+    _taskManager = &locate_service<task_manager>();
 
-        return nullptr;
-    };
-    worldDef.finishTask = [](void* /* userTask */, void* /* userContext */) {
+    if (settings.EnableAsyncTasks) {
+        // a task runs on at most one pool task per thread plus the stepping thread
+        _workerCount = static_cast<i32>(_taskManager->thread_count()) + 1;
+
+        worldDef.workerCount     = _workerCount;
+        worldDef.enqueueTask     = &b2d_world::enqueue_task;
+        worldDef.finishTask      = &b2d_world::finish_task;
+        worldDef.userTaskContext = this;
+    } else {
+        worldDef.workerCount = static_cast<i32>(_taskManager->thread_count());
+        worldDef.enqueueTask = [](b2TaskCallback* task, int32_t itemCount, int32_t minRange, void* taskContext, void* /* userContext */) -> void* {
+            locate_service<task_manager>().run_parallel(
+                [task, taskContext](par_task const& ctx) {
+                    task(static_cast<i32>(ctx.Start), static_cast<i32>(ctx.End), static_cast<i32>(ctx.Thread), taskContext);
+                },
+                itemCount, minRange);
+
+            return nullptr;
+        };
+        worldDef.finishTask = [](void* /* userTask */, void* /* userContext */) {
+
+        };
+    }
 
-    };
     ID = b2CreateWorld(&worldDef);
 }
 
 b2d_world::~b2d_world()
 {
     b2DestroyWorld(ID);
+
+    // pool tasks may still be queued after their last chunk was taken by someone else
+    for (auto const& record : _tasks) {
+        while (record->Refs.load(std::memory_order_acquire) > 0) { std::this_thread::yield(); }
+    }
+}
+
+auto b2d_world::enqueue_task(b2TaskCallback* task, i32 itemCount, i32 minRange, void* taskContext, void* userContext) -> void*
+{
+    auto& self {*static_cast<b2d_world*>(userContext)};
+
+    i32 const poolSize {self._workerCount - 1};
+    if (poolSize == 0 || itemCount <= 0) {
+        task(0, itemCount, 0, taskContext);
+        return nullptr;
+    }
+
+    // Box2D only enqueues from the stepping thread, so the record list needs no locking
+    task_record* record {self.acquire_task()};
+    record->Callback   = task;
+    record->Context    = taskContext;
+    record->ItemCount  = itemCount;
+    record->ChunkCount = std::clamp(itemCount / std::max(minRange, 1), 1, poolSize);
+    record->NextChunk.store(0, std::memory_order_relaxed);
+    record->NextWorker.store(0, std::memory_order_relaxed);
+    record->DoneChunks.store(0, std::memory_order_relaxed);
+    record->Refs.store(record->ChunkCount, std::memory_order_relaxed);
+
+    // every chunk gets a pool task, but whoever comes first claims the next chunk;
+    // this keeps single item tasks like the solver workers truly concurrent
+    for (i32 i {0}; i < record->ChunkCount; ++i) {
+        self._taskManager->run_detached([record] {
+            run_chunks(*record);
+            record->Refs.fetch_sub(1, std::memory_order_release);
+        });
+    }
+
+    return record;
+}
+
+void b2d_world::finish_task(void* userTask, void* userContext)
+{
+    auto& self {*static_cast<b2d_world*>(userContext)};
+    auto* record {static_cast<task_record*>(userTask)};
+
+    // help with unclaimed chunks instead of blocking right away
+    run_chunks(*record);
+
+    for (i32 done {record->DoneChunks.load(std::memory_order_acquire)}; done < record->ChunkCount;
+         done = record->DoneChunks.load(std::memory_order_acquire)) {
+        record->DoneChunks.wait(done, std::memory_order_acquire);
+    }
+
+    self._freeTasks.push_back(record);
+}
+
+void b2d_world::run_chunks(task_record& record)
+{
+    // indices come from the record rather than the thread, so they stay below the worker
+    // count whichever thread ends up running a chunk; there are at most ChunkCount + 1 participants
+    i32 workerIndex {-1};
+    for (i32 chunk {record.NextChunk.fetch_add(1, std::memory_order_relaxed)}; chunk < record.ChunkCount;
+         chunk = record.NextChunk.fetch_add(1, std::memory_order_relaxed)) {
+        if (workerIndex == -1) { workerIndex = record.NextWorker.fetch_add(1, std::memory_order_relaxed); }
+
+        i32 const start {static_cast<i32>(static_cast<i64>(record.ItemCount) * chunk / record.ChunkCount)};
+        i32 const end {static_cast<i32>(static_cast<i64>(record.ItemCount) * (chunk + 1) / record.ChunkCount)};
+        record.Callback(start, end, workerIndex, record.Context);
+
+        if (record.DoneChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == record.ChunkCount) {
+            record.DoneChunks.notify_all();
+        }
+    }
+}
+
+auto b2d_world::acquire_task() -> task_record*
+{
+    // a finished record can only be reused once all of its pool tasks have let go of it
+    auto it {std::ranges::find_if(_freeTasks, [](task_record const* record) { return record->Refs.load(std::memory_order_acquire) == 0; })};
+    if (it != _freeTasks.end()) {
+        task_record* record {*it};
+        *it = _freeTasks.back();
+        _freeTasks.pop_back();
+        return record;
+    }
+
+    return _tasks.emplace_back(std::make_unique<task_record>()).get();
 }
 
 void b2d_world::step(f32 delta, i32 subSteps) const
@@ -6,6 +6,8 @@
 #pragma once
 #include "tcob/tcob_config.hpp"
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
 #include <box2d/box2d.h>
@@ -15,6 +17,7 @@
 #include "tcob/core/AngleUnits.hpp"
 #include "tcob/core/Point.hpp"
 #include "tcob/core/Rect.hpp"
+#include "tcob/core/TaskManager.hpp"
 #include "tcob/physics/B2DBody.hpp"
 #include "tcob/physics/B2DJoint.hpp"
 #include "tcob/physics/B2DShape.hpp"
@@ -60,6 +63,29 @@ public:
     auto get_awake_body_count() const -> i32;
 
     b2WorldId ID {};
+
+private:
+    struct task_record {
+        b2TaskCallback*  Callback {nullptr};
+        void*            Context {nullptr};
+        i32              ItemCount {0};
+        i32              ChunkCount {0};
+        std::atomic<i32> NextChunk {0};
+        std::atomic<i32> NextWorker {0}; //!< Box2D worker index for the next participant
+        std::atomic<i32> DoneChunks {0};
+        std::atomic<i32> Refs {0}; //!< queued or running pool tasks still referencing the record
+    };
+
+    static auto enqueue_task(b2TaskCallback* task, i32 itemCount, i32 minRange, void* taskContext, void* userContext) -> void*;
+    static void finish_task(void* userTask, void* userContext);
+    static void run_chunks(task_record& record);
+
+    auto acquire_task() -> task_record*;
+
+    task_manager*                             _taskManager;
+    i32                                       _workerCount {1}; //!< pool tasks plus the stepping thread
+    std::vector<std::unique_ptr<task_record>> _tasks;
+    std::vector<task_record*>                 _freeTasks;
 };
 
 ////////////////////////////////////////////////////////////
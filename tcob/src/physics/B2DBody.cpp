@@ -35,9 +35,11 @@ body::body(world& world, detail::b2d_world* b2dWorld, body_transform const& xfor
     , SleepThreshold {detail::make_prop<f32, &detail::b2d_body::get_sleep_threshold, &detail::b2d_body::set_sleep_threshold>(this)}
     , Enabled {detail::make_prop<bool, &detail::b2d_body::get_enabled, &detail::b2d_body::set_enabled>(this)}
     , Name {detail::make_prop<string, &detail::b2d_body::get_name, &detail::b2d_body::set_name>(this)}
-    , Transform {detail::make_prop<body_transform, &detail::b2d_body::get_transform, &detail::b2d_body::set_transform>(this)}
+    , Transform {make_prop_fn<body_transform, &body::get_transform, &body::set_transform>(this)}
     , _impl {std::make_unique<detail::b2d_body>(b2dWorld, xform, bodySettings)}
     , _world {world}
+    , _previousTransform {xform}
+    , _currentTransform {xform}
 {
     _impl->set_user_data(this);
 }
@@ -89,6 +91,37 @@ auto body::rotation() const -> radian_f
     return _impl->get_rotation();
 }
 
+auto body::get_transform() const -> body_transform
+{
+    return _impl->get_transform();
+}
+
+void body::set_transform(body_transform const& value)
+{
+    _impl->set_transform(value);
+
+    // a teleport must not be interpolated, neither now nor from the next step on
+    _previousTransform = value;
+    _currentTransform  = value;
+    _lastMoveStep      = _world.step_count();
+}
+
+auto body::interpolated_transform() const -> body_transform
+{
+    // not moved by the last step
+    if (_lastMoveStep != _world.step_count()) { return *Transform; }
+
+    f32 const alpha {_world.interpolation_alpha()};
+
+    // rotate along the shorter arc
+    f32 angleDiff {_currentTransform.Angle.Value - _previousTransform.Angle.Value};
+    if (angleDiff > TAU_F / 2) { angleDiff -= TAU_F; }
+    if (angleDiff < -TAU_F / 2) { angleDiff += TAU_F; }
+
+    return {.Center = point_f::Lerp(_previousTransform.Center, _currentTransform.Center, alpha),
+            .Angle  = radian_f {_previousTransform.Angle.Value + (angleDiff * alpha)}};
+}
+
 auto body::rotational_inertia() const -> f32
 {
     return _impl->get_rotational_inertia();
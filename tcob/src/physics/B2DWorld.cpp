@@ -5,6 +5,8 @@
 
 #include "tcob/physics/B2DWorld.hpp"
 
+#include <algorithm>
+#include <cmath>
 #include <memory>
 #include <vector>
 
@@ -105,9 +107,54 @@ void world::set_contact_tuning(f32 hertz, f32 damping, f32 pushSpeed) const
     _impl->set_contact_tuning(hertz, damping, pushSpeed);
 }
 
+auto world::interpolation_alpha() const -> f32
+{
+    return _alpha;
+}
+
+auto world::step_count() const -> u64
+{
+    return _stepCount;
+}
+
 void world::on_update(milliseconds deltaTime)
+{
+    if (!FixedTimeStep || FixedTimeStep->count() <= 0) {
+        step(deltaTime);
+        _alpha = 1.0f;
+        return;
+    }
+
+    milliseconds const stepSize {*FixedTimeStep};
+    _accumulator += deltaTime;
+
+    i32 steps {0};
+    while (_accumulator >= stepSize && steps < MaxStepsPerUpdate) {
+        step(stepSize);
+        _accumulator -= stepSize;
+        ++steps;
+    }
+
+    // spiral of death: drop the whole steps that did not fit into this update
+    if (_accumulator >= stepSize) {
+        _accumulator = milliseconds {std::fmod(_accumulator.count(), stepSize.count())};
+    }
+
+    _alpha = std::clamp(static_cast<f32>(_accumulator / stepSize), 0.0f, 1.0f);
+}
+
+void world::step(milliseconds deltaTime)
 {
     _impl->step(static_cast<f32>(deltaTime.count() / 1000), SubSteps);
+    ++_stepCount;
+
+    // record the transforms for interpolation, bodies that did not move keep theirs
+    for (auto const& ev : _impl->get_body_events().Move) {
+        if (!ev.Body) { continue; }
+        ev.Body->_previousTransform = ev.Body->_currentTransform;
+        ev.Body->_currentTransform  = ev.Transform;
+        ev.Body->_lastMoveStep      = _stepCount;
+    }
 }
 
 }